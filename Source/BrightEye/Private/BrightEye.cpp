@@ -5,10 +5,27 @@
 #include "BrightEyeManager.h"
 #include "ISettingsModule.h"
 #include "Data/BrightEyeSettings.h"
+#include "System/BrightEyeStats.h"
 #include "System/BrightEyeStyle.h"
 
 #define LOCTEXT_NAMESPACE "FBrightEyeModule"
 
+DEFINE_STAT(STAT_BrightEyeTick);
+DEFINE_STAT(STAT_BrightEyeTickCost);
+DEFINE_STAT(STAT_BrightEyeDegradationLevel);
+DEFINE_STAT(STAT_BrightEyeTraceFlush);
+DEFINE_STAT(STAT_BrightEyeTracesSubmitted);
+DEFINE_STAT(STAT_BrightEyeTracesExecuted);
+DEFINE_STAT(STAT_BrightEyeLivePanels);
+DEFINE_STAT(STAT_BrightEyeLiveHelperActors);
+DEFINE_STAT(STAT_BrightEyeFadeTickers);
+
+int32 FBrightEyeLiveCounts::Panels = 0;
+int32 FBrightEyeLiveCounts::FadeTickers = 0;
+int32 FBrightEyeLiveCounts::CoreTickers = 0;
+int32 FBrightEyeLiveCounts::OverlayDrawHandles = 0;
+int32 FBrightEyeLiveCounts::SceneDelegateBindings = 0;
+
 void FBrightEyeModule::StartupModule()
 {
 	FBrightEyeStyle::InitializeToolStyle();
@@ -4,13 +4,17 @@
 #include "BrightEyeManager.h"
 #include "System/Commands.h"
 #include "System/InputProcessor.h"
+#include "System/BrightEyeStats.h"
+#include "System/BrightEyeViewExtension.h"
 #include "LevelEditor.h"
 #include "SLevelViewport.h"
+#include "Components/LineBatchComponent.h"
 #include "Components/SpotLightComponent.h"
+#include "Engine/LevelBounds.h"
 #include "UnrealEdMisc.h"
+#include "Data/BrightEyeActor.h"
 #include "Data/BrightEyeSettings.h"
-#include "Subsystems/EditorActorSubsystem.h"
-#include "Data/ColorPicker.h"
+#include "ConvexVolume.h"
 #include "Helpers/GeometryUtils.h"
 #include "UI/BrightEyePanel.h"
 
@@ -20,10 +24,27 @@ TSharedPtr<FBrightEyeManagerImp> FBrightEyeManager::BrightEyeManagerImp;
 static constexpr float MAX_DELAY_SPEED = 40.0f;
 static constexpr float MIN_DELAY_SPEED = 4.0f;
 
+// Half-life of the smoothing spring that matches an exponential follow at the given delay speed.
+static float DelaySpeedToHalfLife(const float InDelaySpeed)
+{
+	return 0.69314718f / InDelaySpeed;
+}
+
 static constexpr float DROP_CHECK_TIME = 0.1f;
 
 static constexpr float ConfigSaveInterval = 1.0f;
 
+static constexpr float STAMP_CULL_INTERVAL = 0.2f;
+
+static constexpr float PANEL_REFRESH_INTERVAL = 0.1f;
+
+static constexpr float WHEEL_STEP = 0.01f;
+static constexpr float WHEEL_SPEED_SMOOTHING = 0.15f;
+static constexpr float WHEEL_ACCELERATION_SPEED = 10.0f;
+static constexpr float WHEEL_MAX_ACCELERATION = 5.0f;
+static constexpr int32 DEGRADED_TRACE_INTERVAL = 4;
+static constexpr int32 DEGRADED_SUBSTEP_STRIDE = 4;
+
 void FBrightEyeManagerImp::Initialize()
 {
 	ActivateInputProcessor();
@@ -31,6 +52,8 @@ void FBrightEyeManagerImp::Initialize()
 	InitCommands();
 
 	SetupDelegates();
+
+	ApplyLightOverlay();
 }
 
 void FBrightEyeManagerImp::Shutdown()
@@ -38,9 +61,118 @@ void FBrightEyeManagerImp::Shutdown()
 	DeactivateInputProcessor();
 
 	RemoveDelegates();
+
+	ViewExtension.Reset();
+	bIsFollowingViewOnRender = false;
+
+	LightOverlay.SetEnabled(false);
+
+	// Saves that were deferred by the frame budget are not lost.
+	if (bLightSettingsModified && UBESettings::GetInstance())
+	{
+		UBESettings::GetInstance()->SaveToolConfig();
+		bLightSettingsModified = false;
+	}
+
+	BudgetGovernor.Reset();
+	ApplyDegradationLevel();
 }
 
 void FBrightEyeManagerImp::OnScalarParamChanged(const float& InNewParam, EBEScalarParamType InParamType)
+{
+	// Slider drags can report many values per frame; only the last one is applied.
+	PendingScalarParams[static_cast<int32>(InParamType)].Value = InNewParam;
+}
+
+bool FBrightEyeManagerImp::HandleParamWheel(const FModifierKeysState& InModifiers, const float InNotches)
+{
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+	if (IsInPie() || !IsValid(ToolSettings) || !ToolSettings->bWheelAdjustsParameters || !InModifiers.IsAltDown()) { return false; }
+
+	if (!IsValid(BrightEyeComponent) || !BrightEyeComponent->IsVisible()) { return false; }
+
+	TSharedPtr<SLevelViewport> ViewportPtr = ActiveViewport.Pin();
+	if (!ViewportPtr.IsValid() || !ViewportPtr->GetActiveViewport()->HasFocus()) { return false; }
+
+	EBEScalarParamType ParamType = EBEScalarParamType::Brightness;
+	if (InModifiers.IsShiftDown())
+	{
+		ParamType = EBEScalarParamType::Radius;
+	}
+	else if (InModifiers.IsControlDown())
+	{
+		ParamType = EBEScalarParamType::Distance;
+	}
+
+	PendingScalarParams[static_cast<int32>(ParamType)].WheelNotches += InNotches;
+	return true;
+}
+
+void FBrightEyeManagerImp::FlushPendingScalarParams(const float& InDeltaTime)
+{
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+	if (!IsValid(ToolSettings)) { return; }
+
+	float FrameNotches = 0.0f;
+	for (const FPendingScalarParam& Pending : PendingScalarParams)
+	{
+		FrameNotches += FMath::Abs(Pending.WheelNotches);
+	}
+
+	// Continuous scrolling speeds up the change, a single notch stays a fine step.
+	if (InDeltaTime > 0.0f)
+	{
+		const float Blend = 1.0f - FMath::Exp(-InDeltaTime / WHEEL_SPEED_SMOOTHING);
+		WheelSpeed = FMath::Lerp(WheelSpeed, FrameNotches / InDeltaTime, Blend);
+	}
+	const float Acceleration = FMath::Clamp(WheelSpeed / WHEEL_ACCELERATION_SPEED, 1.0f, WHEEL_MAX_ACCELERATION);
+
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(PendingScalarParams); ++Index)
+	{
+		FPendingScalarParam& Pending = PendingScalarParams[Index];
+		if (!Pending.Value.IsSet() && Pending.WheelNotches == 0.0f) { continue; }
+
+		const EBEScalarParamType ParamType = static_cast<EBEScalarParamType>(Index);
+
+		// Manual changes take over from a running preset transition.
+		PresetTransition.bIsActive = false;
+
+		float CurrentValue = ToolSettings->Brightness;
+		if (ParamType == EBEScalarParamType::Radius)
+		{
+			CurrentValue = ToolSettings->Radius;
+		}
+		else if (ParamType == EBEScalarParamType::Distance)
+		{
+			CurrentValue = ToolSettings->Distance;
+		}
+
+		const float NewValue = FMath::Clamp(Pending.Value.Get(CurrentValue) + Pending.WheelNotches * WHEEL_STEP * Acceleration, 0.01f, 1.0f);
+		ApplyScalarParam(NewValue, ParamType);
+
+		// The sliders already show their own value; wheel changes have to be pushed to them.
+		if (Pending.WheelNotches != 0.0f && BrightEyePanel.IsValid())
+		{
+			if (ParamType == EBEScalarParamType::Brightness)
+			{
+				BrightEyePanel->RefreshBrightness();
+			}
+			else if (ParamType == EBEScalarParamType::Radius)
+			{
+				BrightEyePanel->RefreshRadius();
+			}
+			else
+			{
+				BrightEyePanel->RefreshDistance();
+			}
+		}
+
+		// Cleared last, so the value echoed back by the refreshed slider is dropped too.
+		Pending = FPendingScalarParam();
+	}
+}
+
+void FBrightEyeManagerImp::ApplyScalarParam(const float InNewParam, const EBEScalarParamType InParamType)
 {
 	UBESettings* ToolSettings = UBESettings::GetInstance();
 
@@ -70,17 +202,37 @@ void FBrightEyeManagerImp::OnScalarParamChanged(const float& InNewParam, EBEScal
 
 void FBrightEyeManagerImp::OnColorParamChanged(const FLinearColor& InNewColor)
 {
+	// The wheel reports every mouse move while dragging; only the last color of the frame is applied.
+	PendingColor = InNewColor;
+}
+
+void FBrightEyeManagerImp::OnTemperatureParamChanged(const float& InNewTemperature)
+{
+	PendingTemperature = InNewTemperature;
+}
+
+void FBrightEyeManagerImp::FlushPendingColorParams()
+{
+	if (!PendingColor.IsSet() && !PendingTemperature.IsSet()) { return; }
+
 	UBESettings* ToolSettings = UBESettings::GetInstance();
 
-	if (!ActiveViewport.IsValid() || !IsValid(ToolSettings)) { return; }
+	if (ActiveViewport.IsValid() && IsValid(ToolSettings))
+	{
+		PresetTransition.bIsActive = false;
 
-	ToolSettings->Color = InNewColor;
+		ToolSettings->Color = PendingColor.Get(ToolSettings->Color);
+		ToolSettings->ColorTemperature = PendingTemperature.Get(ToolSettings->ColorTemperature);
 
-	UpdateColor();
+		UpdateColor();
 
-	ForceViewportRedraw();
+		ForceViewportRedraw();
 
-	ResetLightModificationState();
+		ResetLightModificationState();
+	}
+
+	PendingColor.Reset();
+	PendingTemperature.Reset();
 }
 
 void FBrightEyeManagerImp::OnSmoothRotationToggled()
@@ -104,15 +256,31 @@ void FBrightEyeManagerImp::OnBrightEyeSettingsChangedOnEditorSettings(const FPro
 		static const FName MaxBrightnessName("MaxBrightness");
 		static const FName MaxDistanceName("MaxDistance");
 		static const FName ColorName("Color");
+		static const FName ColorTemperatureName("ColorTemperature");
 		static const FName ActivateLightOnPressName("bActivateLightOnPress");
 		static const FName bHidePanelWhenIdleName("bHidePanelWhenIdle");
 		static const FName bSmoothCameraRotationName("bSmoothLightRotation");
 		static const FName LightProfileName("LightProfile");
+		static const FName RigPresetsName("RigPresets");
+		static const FName ActiveRigPresetName("ActiveRigPreset");
+		static const FName LightPresetsName("LightPresets");
+		static const FName bShowLightOverlayName("bShowLightOverlay");
+		static const FName bEstimateLightCostName("bEstimateLightCost");
+		static const FName bCapLightCostName("bCapLightCost");
 
 		const UBESettings* ToolSettings = UBESettings::GetInstance();
 		if (!IsValid(ToolSettings)) { return; }
 
-		if (InPropertyChangedEvent.GetPropertyName() == BrightnessName)
+		// Rig lights have their own Color and other fields, so the whole rig is matched first.
+		if (InPropertyChangedEvent.GetMemberPropertyName() == RigPresetsName || InPropertyChangedEvent.GetMemberPropertyName() == ActiveRigPresetName)
+		{
+			ApplyLightRig();
+		}
+		else if (InPropertyChangedEvent.GetMemberPropertyName() == LightPresetsName)
+		{
+			PreloadPresetProfiles();
+		}
+		else if (InPropertyChangedEvent.GetPropertyName() == BrightnessName)
 		{
 			UpdateBrightness();
 
@@ -149,7 +317,7 @@ void FBrightEyeManagerImp::OnBrightEyeSettingsChangedOnEditorSettings(const FPro
 			UpdateDistance();
 			UpdateBrightness();
 		}
-		else if (InPropertyChangedEvent.GetPropertyName() == ColorName)
+		else if (InPropertyChangedEvent.GetPropertyName() == ColorName || InPropertyChangedEvent.GetPropertyName() == ColorTemperatureName)
 		{
 			UpdateColor();
 			if (BrightEyePanel.IsValid())
@@ -162,7 +330,7 @@ void FBrightEyeManagerImp::OnBrightEyeSettingsChangedOnEditorSettings(const FPro
 			if (ToolSettings->bActivateLightOnPress && IsValid(BrightEyeActor) && IsValid(BrightEyeComponent) &&
 				BrightEyeComponent->IsVisible())
 			{
-				BrightEyeComponent->SetVisibility(false);
+				BrightEyeComponent->SetVisibility(false, true);
 			}
 		}
 		else if (InPropertyChangedEvent.GetPropertyName() == bHidePanelWhenIdleName)
@@ -185,6 +353,25 @@ void FBrightEyeManagerImp::OnBrightEyeSettingsChangedOnEditorSettings(const FPro
 		{
 			UpdateLightProfile();
 		}
+		else if (InPropertyChangedEvent.GetPropertyName() == bShowLightOverlayName)
+		{
+			ApplyLightOverlay();
+		}
+		else if (InPropertyChangedEvent.GetPropertyName() == bEstimateLightCostName || InPropertyChangedEvent.GetPropertyName() == bCapLightCostName)
+		{
+			if (!ToolSettings->bEstimateLightCost || !ToolSettings->bCapLightCost)
+			{
+				ClearLightCostCap();
+			}
+
+			if (!ToolSettings->bEstimateLightCost)
+			{
+				LightCostEstimator.Reset();
+				RefreshSceneDelegates();
+			}
+
+			LightCostSummary = BuildLightCostSummary();
+		}
 		else
 		{
 			UpdateLightViewOffsetOnPanel();
@@ -194,11 +381,16 @@ void FBrightEyeManagerImp::OnBrightEyeSettingsChangedOnEditorSettings(const FPro
 	}
 }
 
-void FBrightEyeManagerImp::OnResetBrightEyeSettings() const
+void FBrightEyeManagerImp::OnResetBrightEyeSettings()
 {
-	if (IsValid(BrightEyeActor) && IsValid(BrightEyeComponent))
+	ApplyLightOverlay();
+	ClearLightCostCap();
 
+	if (IsValid(BrightEyeActor) && IsValid(BrightEyeComponent))
+	{
 		UpdateBrightEyeSpecs();
+		ApplyLightRig();
+	}
 }
 
 void FBrightEyeManagerImp::UpdateBrightEyeSpecs() const
@@ -214,6 +406,12 @@ void FBrightEyeManagerImp::UpdateBrightness() const
 {
 	if(!IsValid(BrightEyeComponent)){return;}
 	
+	BrightEyeComponent->SetIntensity(ComputeIntensity());
+	LightRig.SyncWithMainLight();
+}
+
+float FBrightEyeManagerImp::ComputeIntensity()
+{
 	if (const UBESettings* ToolSettings = UBESettings::GetInstance())
 	{
 		float t = ToolSettings->Distance;
@@ -227,42 +425,85 @@ void FBrightEyeManagerImp::UpdateBrightness() const
 			return c * t * t * t * t + b;
 		};
 
-		float CalculatedBrightness = EaseInQuart(t, b, c, d);
-		float NewBrightness = CalculatedBrightness;
-		BrightEyeComponent->SetIntensity(NewBrightness);
+		return EaseInQuart(t, b, c, d);
 	}
+	return 0.0f;
 }
 
-void FBrightEyeManagerImp::UpdateRadius() const
+float FBrightEyeManagerImp::ComputeOuterConeAngle()
 {
-	if(!IsValid(BrightEyeComponent)){return;}
-	
 	if (const UBESettings* ToolSettings = UBESettings::GetInstance())
 	{
-		float NewRadius = 1 + ToolSettings->Radius * 79;
-		BrightEyeComponent->SetOuterConeAngle(NewRadius);
+		return 1 + ToolSettings->Radius * 79;
 	}
+	return 1;
 }
 
-void FBrightEyeManagerImp::UpdateDistance() const
+void FBrightEyeManagerImp::ApplyLightParams() const
+{
+	if(!IsValid(BrightEyeComponent)){return;}
+
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+	if(!IsValid(ToolSettings)){return;}
+
+	// Intensity and color take the setters' lightweight color and brightness update; the shape setters skip unchanged values.
+	BrightEyeComponent->SetIntensity(ComputeIntensity());
+	BrightEyeComponent->SetLightColor(ComputeLightColor());
+	BrightEyeComponent->SetOuterConeAngle(ComputeOuterConeAngle());
+	BrightEyeComponent->SetAttenuationRadius(GetEffectiveAttenuationRadius());
+
+	LightRig.SyncWithMainLight();
+}
+
+void FBrightEyeManagerImp::UpdateRadius() const
 {
 	if(!IsValid(BrightEyeComponent)){return;}
 	
+	BrightEyeComponent->SetOuterConeAngle(ComputeOuterConeAngle());
+}
+
+void FBrightEyeManagerImp::UpdateDistance() const
+{
+	if(!IsValid(BrightEyeComponent)){return;}
+
+	BrightEyeComponent->SetAttenuationRadius(GetEffectiveAttenuationRadius());
+	LightRig.SyncWithMainLight();
+}
+
+float FBrightEyeManagerImp::GetEffectiveAttenuationRadius() const
+{
+	float NewDistance = GetConfiguredAttenuationRadius();
+	if (bIsLightCostCapped)
+	{
+		NewDistance = FMath::Min(NewDistance, CappedAttenuationRadius);
+	}
+	return NewDistance;
+}
+
+float FBrightEyeManagerImp::GetConfiguredAttenuationRadius()
+{
 	if (const UBESettings* ToolSettings = UBESettings::GetInstance())
 	{
-		float NewDistance = 3000 + ToolSettings->Distance * (ToolSettings->MaxDistance - 3000);
-		BrightEyeComponent->SetAttenuationRadius(NewDistance);
+		return 3000 + ToolSettings->Distance * (ToolSettings->MaxDistance - 3000);
 	}
+	return 3000;
 }
 
 void FBrightEyeManagerImp::UpdateColor() const
 {
 	if(!IsValid(BrightEyeComponent)){return;}
 	
+	BrightEyeComponent->SetLightColor(ComputeLightColor());
+}
+
+FLinearColor FBrightEyeManagerImp::ComputeLightColor()
+{
 	if (const UBESettings* ToolSettings = UBESettings::GetInstance())
 	{
-		BrightEyeComponent->SetLightColor(ToolSettings->Color);
+		// Temperature is folded into the color, so stamps and baked lights copy it along with the tint.
+		return ToolSettings->Color * FLinearColor::MakeFromColorTemperature(ToolSettings->ColorTemperature);
 	}
+	return FLinearColor::White;
 }
 
 void FBrightEyeManagerImp::UpdateLightProfile() const
@@ -344,11 +585,11 @@ void FBrightEyeManagerImp::SetupDelegates()
 	});
 
 	LevelEditor.OnMapChanged().AddRaw(this, &FBrightEyeManagerImp::OnMapChanged);
-	LevelEditor.OnActorSelectionChanged().AddRaw(this, &FBrightEyeManagerImp::OnActorSelectionChanged);
 
 	FEditorDelegates::BeginPIE.AddRaw(this, &FBrightEyeManagerImp::HandleBeginPIE);
 	
 	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBrightEyeManagerImp::OnTick));
+	++FBrightEyeLiveCounts::CoreTickers;
 
 	if (IsValid(UBESettings::GetInstance()))
 	{
@@ -357,17 +598,20 @@ void FBrightEyeManagerImp::SetupDelegates()
 	}
 }
 
-void FBrightEyeManagerImp::RemoveDelegates() const
+void FBrightEyeManagerImp::RemoveDelegates()
 {
+	UnbindSceneDelegates();
+
 	FEditorDelegates::BeginPIE.RemoveAll(this);
 	
 	FLevelEditorModule& LevelEditor = FModuleManager::GetModuleChecked<FLevelEditorModule>(TEXT("LevelEditor"));
 	LevelEditor.OnMapChanged().RemoveAll(this);
-	LevelEditor.OnActorSelectionChanged().RemoveAll(this);
 
 	if (TickHandle.IsValid())
 	{
 		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+		--FBrightEyeLiveCounts::CoreTickers;
 	}
 
 	if (LevelEditor.GetFirstLevelEditor().IsValid())
@@ -389,16 +633,25 @@ void FBrightEyeManagerImp::HandleBeginPIE(const bool bIsSimulating)
 
 bool FBrightEyeManagerImp::OnTick(float InDeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_BrightEyeTick);
+	const uint64 TickStartCycles = FPlatformTime::Cycles64();
+
 	if (ActiveViewport.IsValid() && IsValid(BrightEyeActor) && IsValid(BrightEyeComponent))
 	{
-		UpdateLightTransformWithViewport(InDeltaTime);
+		if (!TryFollowViewOnRender())
+		{
+			UpdateLightTransformWithViewport(InDeltaTime);
+		}
 	}
 
+	// Rays queued by this tick and by the last view setup are traced together.
+	FGeometryUtils::FlushTraces();
+
 	if (bLightSettingsModified)
 	{
 		TimeSinceLastModification += InDeltaTime;
 
-		if (TimeSinceLastModification >= ConfigSaveInterval)
+		if (TimeSinceLastModification >= ConfigSaveInterval && !BudgetGovernor.IsAtLeast(EBEDegradationLevel::DeferPanelAndConfig))
 		{
 			UBESettings::GetInstance()->SaveToolConfig();
 
@@ -410,6 +663,27 @@ bool FBrightEyeManagerImp::OnTick(float InDeltaTime)
 	{
 		CheckForOutOfBoundDropping(InDeltaTime);
 	}
+
+	if (LightStamps.Num() > 0)
+	{
+		CullLightStamps(InDeltaTime);
+	}
+
+	if (DarkSpotFinder.NeedsTick())
+	{
+		RefreshDarkSpots();
+	}
+
+	AdvancePresetTransition(InDeltaTime);
+
+	FlushPendingScalarParams(InDeltaTime);
+	FlushPendingColorParams();
+
+	UpdateLightCost(InDeltaTime);
+
+	RefreshPanelSummaries(InDeltaTime);
+
+	UpdateFrameBudget(InDeltaTime, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - TickStartCycles));
 	
 	return true;
 }
@@ -438,34 +712,24 @@ void FBrightEyeManagerImp::OnMapChanged(UWorld* World, EMapChangeType MapChangeT
 {
 	if (World && MapChangeType != EMapChangeType::SaveMap)
 	{
+		LightStamps.Clear();
+		ClearDarkSpots();
+		LightCostEstimator.Reset();
+		bIsLightCostCapped = false;
+		CappedAttenuationRadius = 0.0f;
+		RefreshSceneDelegates();
 		DestroyBrightLight();
 		DestroyBrightEyePanel();
 	}
 }
 
-void FBrightEyeManagerImp::OnActorSelectionChanged(const TArray<UObject*>& InActors, bool bIsSelected) const
-{
-	if (!BrightEyeActor || !GEditor) { return; }
-
-	for (UObject* CurrentSelectedActor : InActors)
-	{
-		if (CurrentSelectedActor == BrightEyeActor)
-		{
-			if (UEditorActorSubsystem* EditorActorSubsystem = GEditor->GetEditorSubsystem<UEditorActorSubsystem>())
-			{
-				return EditorActorSubsystem->SetActorSelectionState(BrightEyeActor, false);
-			}
-		}
-	}
-}
-
 void FBrightEyeManagerImp::ResetBrightEyeRotation()
 {
 	TSharedPtr<FLevelEditorViewportClient> ViewportClient = StaticCastSharedPtr<FLevelEditorViewportClient>(
 		ActiveViewport.Pin()->GetViewportClient());
 	if (ViewportClient.IsValid())
 	{
-		BrightEyeRotation = ViewportClient->GetViewRotation();
+		LightSmoother.Reset(ViewportClient->GetViewRotation().Quaternion());
 	}
 }
 
@@ -478,6 +742,7 @@ void FBrightEyeManagerImp::ActivateInputProcessor()
 		InputProcessor = MakeShared<FBEInputPreProcessor>();
 		InputProcessor->OnKeySelected.BindRaw(this, &FBrightEyeManagerImp::HandleKeySelected);
 		InputProcessor->OnKeReleased.BindRaw(this, &FBrightEyeManagerImp::HandleKeyReleased);
+		InputProcessor->OnParamWheel.BindRaw(this, &FBrightEyeManagerImp::HandleParamWheel);
 
 		FSlateApplication::Get().RegisterInputPreProcessor(InputProcessor, 0);
 	}
@@ -534,7 +799,7 @@ bool FBrightEyeManagerImp::HandleKeyReleased(const FKeyEvent& InKey)
 		{
 			if(IsValid(BrightEyeComponent))
 			{
-				BrightEyeComponent->SetVisibility(false);
+				BrightEyeComponent->SetVisibility(false, true);
 			}
 			
 			bIsLightActiveBeforeAiming = false;
@@ -560,6 +825,17 @@ void FBrightEyeManagerImp::InitCommands()
 	CameraLevelCommands->MapAction(FBECommands::Get().ToggleBrightEye,FExecuteAction::CreateRaw(this, &FBrightEyeManagerImp::OnToggleLight));
 	CameraLevelCommands->MapAction(FBECommands::Get().ToggleControlPanel,FExecuteAction::CreateRaw(this, &FBrightEyeManagerImp::OnToggleBrightEyePanel));
 	CameraLevelCommands->MapAction(FBECommands::Get().AimBrightEye,FExecuteAction::CreateRaw(this, &FBrightEyeManagerImp::OnAimBrightEye));
+	CameraLevelCommands->MapAction(FBECommands::Get().StampBrightEye,FExecuteAction::CreateRaw(this, &FBrightEyeManagerImp::OnStampBrightEye));
+	CameraLevelCommands->MapAction(FBECommands::Get().ClearLightStamps,FExecuteAction::CreateRaw(this, &FBrightEyeManagerImp::OnClearLightStamps));
+	CameraLevelCommands->MapAction(FBECommands::Get().ConvertLightStamps,FExecuteAction::CreateRaw(this, &FBrightEyeManagerImp::OnConvertLightStamps));
+	CameraLevelCommands->MapAction(FBECommands::Get().ToggleDarkSpots,FExecuteAction::CreateRaw(this, &FBrightEyeManagerImp::OnToggleDarkSpots));
+	CameraLevelCommands->MapAction(FBECommands::Get().AimAtDarkestSpot,FExecuteAction::CreateRaw(this, &FBrightEyeManagerImp::OnAimAtDarkestSpot));
+	CameraLevelCommands->MapAction(FBECommands::Get().ToggleLightOverlay,FExecuteAction::CreateRaw(this, &FBrightEyeManagerImp::OnToggleLightOverlay));
+
+	for (int32 Index = 0; Index < FBECommands::Get().ApplyPresetCommands.Num(); ++Index)
+	{
+		CameraLevelCommands->MapAction(FBECommands::Get().ApplyPresetCommands[Index],FExecuteAction::CreateRaw(this, &FBrightEyeManagerImp::OnApplyPreset, Index));
+	}
 }
 
 #pragma endregion Input
@@ -580,18 +856,18 @@ void FBrightEyeManagerImp::OnToggleLight()
 		{
 			if (ToolSettings->bActivateLightOnPress)
 			{
-				if(IsValid(BrightEyeComponent)){BrightEyeComponent->SetVisibility(true);}
+				if(IsValid(BrightEyeComponent)){BrightEyeComponent->SetVisibility(true, true);}
 			}
 		}
 		else
 		{
 			if (ToolSettings->bActivateLightOnPress)
 			{
-				if(IsValid(BrightEyeComponent)){BrightEyeComponent->SetVisibility(false);}
+				if(IsValid(BrightEyeComponent)){BrightEyeComponent->SetVisibility(false, true);}
 			}
 			else
 			{
-				if(IsValid(BrightEyeComponent)){BrightEyeComponent->SetVisibility(!BrightEyeComponent->IsVisible());}
+				if(IsValid(BrightEyeComponent)){BrightEyeComponent->SetVisibility(!BrightEyeComponent->IsVisible(), true);}
 			}
 		}
 
@@ -634,7 +910,7 @@ void FBrightEyeManagerImp::SetLightVisibility(bool bVisible) const
 {
 	if (IsValid(BrightEyeComponent))
 	{
-		BrightEyeComponent->SetVisibility(bVisible);
+		BrightEyeComponent->SetVisibility(bVisible, true);
 		InvalidateViewport();
 	}
 }
@@ -642,6 +918,7 @@ void FBrightEyeManagerImp::SetLightVisibility(bool bVisible) const
 void FBrightEyeManagerImp::OnAimBrightEye()
 {
 	bIsAimLighting = bIsAnyControlKeyPressed;
+	PinnedAimLocation.Reset();
 
 	TSharedPtr<SLevelViewport> ViewportPtr = ActiveViewport.Pin();
 	if (!ViewportPtr.IsValid() || !ViewportPtr->GetActiveViewport()->HasFocus()) { return; }
@@ -671,124 +948,795 @@ void FBrightEyeManagerImp::OnAimBrightEye()
 }
 
 
-void FBrightEyeManagerImp::OnPanelDragStarted()
+#pragma region LightStamps
+
+void FBrightEyeManagerImp::OnStampBrightEye()
 {
-	bIsDragging = true;
-	TryHideBrightEyePanel();
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+	if (!IsValid(ToolSettings) || !bIsAnyControlKeyPressed) { return; }
+
+	TSharedPtr<SLevelViewport> ViewportPtr = ActiveViewport.Pin();
+	if (!ViewportPtr.IsValid() || !ViewportPtr->GetActiveViewport()->HasFocus()) { return; }
+
+	if (!IsValid(BrightEyeActor))
+	{
+		CreateBrightEyeLight();
+		UpdateLightTransformWithViewport(0.0f);
+	}
+
+	if (LightStamps.Add(BrightEyeActor, BrightEyeComponent, ToolSettings->MaxLightStamps) != INDEX_NONE)
+	{
+		StampCullTimer = STAMP_CULL_INTERVAL;
+		InvalidateViewport();
+	}
 }
 
-void FBrightEyeManagerImp::CheckForOutOfBoundDropping(const float& InDeltaTime)
+void FBrightEyeManagerImp::OnClearLightStamps()
 {
-	PanelDropTimer  += InDeltaTime;
-	if(PanelDropTimer  >= DROP_CHECK_TIME)
+	if (bIsAnyControlKeyPressed)
 	{
-		bCheckingForDrop = false;
-		if(bIsDragging)
-		{
-			OnPanelDragFinished(BEPanelLocation);
-			bIsDragging = false;
-		}
+		ClearLightStamps();
 	}
 }
 
-void FBrightEyeManagerImp::OnCoordsChanged(const FVector2D& InNewCoords)
+void FBrightEyeManagerImp::OnConvertLightStamps()
 {
-	UBESettings* ToolSettings = UBESettings::GetInstance();
+	if (bIsAnyControlKeyPressed)
+	{
+		ConvertLightStamps();
+	}
+}
 
-	if (!ActiveViewport.IsValid() || !IsValid(ToolSettings)) { return; }
+void FBrightEyeManagerImp::ClearLightStamps()
+{
+	if (LightStamps.Num() == 0) { return; }
 
-	ToolSettings->LightViewOffset = InNewCoords * 100.0f;
-	
+	LightStamps.Clear();
 	ForceViewportRedraw();
-
-	ResetLightModificationState();
 }
 
-void FBrightEyeManagerImp::OnPanelDragFinished(const FVector2D& InDropLocation)
+void FBrightEyeManagerImp::ConvertLightStamps()
 {
-	bIsDragging = false;
-	UpdateBrightEyePanelLocation(InDropLocation);
-	TryRevealBrightEyePanel();
+	if (LightStamps.Num() == 0 || !GEditor) { return; }
+
+	LightStamps.ConvertToLevelActors(GEditor->GetEditorWorldContext().World());
+	ForceViewportRedraw();
 }
 
-void FBrightEyeManagerImp::CreateBrightEyeLight()
+void FBrightEyeManagerImp::OnLightStampsToggled()
 {
-	UWorld* EditorWorld = GEditor->GetEditorWorldContext().World();
-	if (!EditorWorld) return;
-
-	BrightEyeActor = EditorWorld->SpawnActor<AActor>(AActor::StaticClass());
-	if (IsValid(BrightEyeActor))
-	{
-		BrightEyeActor->SetActorLabel(TEXT("Bright Eye Manager"));
-
-		BrightEyeActor->SetFlags(RF_Transient);
+	LightStamps.SetAllEnabled(!LightStamps.AreEnabled());
+	ForceViewportRedraw();
+}
 
-		BrightEyeComponent = NewObject<USpotLightComponent>(BrightEyeActor);
-		if (!IsValid(BrightEyeComponent)) { return; }
+void FBrightEyeManagerImp::OnLightStampsRecolored()
+{
+	LightStamps.SetAllColor(ComputeLightColor());
+	ForceViewportRedraw();
+}
 
-		BrightEyeComponent->RegisterComponent();
-		BrightEyeComponent->AttachToComponent(BrightEyeActor->GetRootComponent(),FAttachmentTransformRules::KeepWorldTransform);
+void FBrightEyeManagerImp::OnLightStampsScaled(const float InScale)
+{
+	LightStamps.ScaleAllIntensity(InScale);
+	ForceViewportRedraw();
+}
 
-		const UBESettings* ToolSettings = UBESettings::GetInstance();
-		if (!IsValid(ToolSettings)) { return; }
+void FBrightEyeManagerImp::CullLightStamps(const float& InDeltaTime)
+{
+	StampCullTimer += InDeltaTime;
+	if (StampCullTimer < STAMP_CULL_INTERVAL) { return; }
 
-		BrightEyeComponent->SetInnerConeAngle(0);
-		BrightEyeComponent->SetCastShadows(false);
+	StampCullTimer = 0.0f;
 
-		ResetBrightEyeRotation();
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+	TSharedPtr<SLevelViewport> ViewportPtr = ActiveViewport.Pin();
+	if (!IsValid(ToolSettings) || !ViewportPtr.IsValid()) { return; }
 
-		UpdateBrightEyeSpecs();
+	const FLevelEditorViewportClient& ViewportClient = ViewportPtr->GetLevelViewportClient();
 
-		BrightEyeComponent->SetVisibility(false);
-		TArray<USceneComponent*> AttachedComponents;
-		BrightEyeComponent->GetChildrenComponents(true, AttachedComponents);
+	FConvexVolume ViewFrustum;
+	const bool bUseFrustum = ToolSettings->bCullStampsOutsideView && FGeometryUtils::GetViewFrustum(&ViewportClient, ViewFrustum);
 
-		for (USceneComponent* Component : AttachedComponents)
-		{
-			if (UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(Component))
-			{
-				PrimitiveComponent->SetVisibility(false);
-			}
-		}
-	}
+	LightStamps.Cull(bUseFrustum ? &ViewFrustum : nullptr, ViewportClient.GetViewLocation(), ToolSettings->StampCullDistance);
 }
 
-void FBrightEyeManagerImp::DestroyBrightLight()
+FText FBrightEyeManagerImp::BuildLightStampSummary() const
 {
-	if (!IsValid(BrightEyeActor)) { return; }
+	if (LightStamps.Num() == 0)
+	{
+		return FText::FromString(TEXT("No stamps"));
+	}
 
-	BrightEyeActor->Destroy();
-	BrightEyeActor = nullptr;
+	return FText::FromString(FString::Printf(TEXT("Stamps %d/%d%s"), LightStamps.NumVisible(), LightStamps.Num(), LightStamps.AreEnabled() ? TEXT("") : TEXT(" (off)")));
 }
 
+#pragma endregion LightStamps
 
+#pragma region LightPresets
 
-void FBrightEyeManagerImp::UpdateLightTransformWithViewport(const float& InDeltaTime)
+void FBrightEyeManagerImp::OnApplyPreset(const int32 InIndex)
 {
-	TSharedPtr<FLevelEditorViewportClient> ViewportClient = StaticCastSharedPtr<FLevelEditorViewportClient>(ActiveViewport.Pin()->GetViewportClient());
+	TSharedPtr<SLevelViewport> ViewportPtr = ActiveViewport.Pin();
+	if (!bIsAnyControlKeyPressed || !ViewportPtr.IsValid() || !ViewportPtr->GetActiveViewport()->HasFocus()) { return; }
+
+	ApplyPreset(InIndex);
+}
+
+void FBrightEyeManagerImp::ApplyPreset(const int32 InIndex)
+{
+	UBESettings* ToolSettings = UBESettings::GetInstance();
+	if (!IsValid(ToolSettings) || !ToolSettings->LightPresets.IsValidIndex(InIndex)) { return; }
 
-	if (ViewportClient.IsValid() && IsValid(BrightEyeComponent) && UBESettings::GetInstance())
+	const FBELightPreset& Preset = ToolSettings->LightPresets[InIndex];
+
+	// Profiles cannot blend, so the new one is set up front. It was preloaded, so this does not hit the disk.
+	if (ToolSettings->LightProfile != Preset.LightProfile)
 	{
-		FVector LightLocation = ViewportClient->GetViewLocation() + ViewportClient->GetViewRotation().Quaternion().GetUpVector() * UBESettings::GetInstance()->LightViewOffset.Y + ViewportClient->GetViewRotation().Quaternion().GetRightVector() * UBESettings::GetInstance()->LightViewOffset.X + ViewportClient->GetViewRotation().Vector() * -20.0f;
-		if(bIsAimLighting)
-		{
-			FVector MouseHitLocation;
-			FGeometryUtils::GetHitLocationFromCameraAndMouse(MouseHitLocation);
+		ToolSettings->LightProfile = Preset.LightProfile;
+		UpdateLightProfile();
+	}
+
+	PresetTransition.From.Brightness = ToolSettings->Brightness;
+	PresetTransition.From.Radius = ToolSettings->Radius;
+	PresetTransition.From.Distance = ToolSettings->Distance;
+	PresetTransition.From.Color = ToolSettings->Color;
+	PresetTransition.From.ColorTemperature = ToolSettings->ColorTemperature;
+	PresetTransition.To = Preset;
+	PresetTransition.Elapsed = 0.0f;
+	PresetTransition.Duration = ToolSettings->PresetTransitionDuration;
+	PresetTransition.bIsActive = true;
+
+	if (PresetTransition.Duration <= 0.0f)
+	{
+		AdvancePresetTransition(0.0f);
+	}
+}
+
+void FBrightEyeManagerImp::AdvancePresetTransition(const float& InDeltaTime)
+{
+	if (!PresetTransition.bIsActive) { return; }
+
+	UBESettings* ToolSettings = UBESettings::GetInstance();
+	if (!IsValid(ToolSettings))
+	{
+		PresetTransition.bIsActive = false;
+		return;
+	}
+
+	PresetTransition.Elapsed += InDeltaTime;
+
+	const float Alpha = PresetTransition.Duration > 0.0f ? FMath::SmoothStep(0.0f, 1.0f, PresetTransition.Elapsed / PresetTransition.Duration) : 1.0f;
+
+	const FBELightPreset& From = PresetTransition.From;
+	const FBELightPreset& To = PresetTransition.To;
+
+	ToolSettings->Brightness = FMath::Lerp(From.Brightness, To.Brightness, Alpha);
+	ToolSettings->Radius = FMath::Lerp(From.Radius, To.Radius, Alpha);
+	ToolSettings->Distance = FMath::Lerp(From.Distance, To.Distance, Alpha);
+	ToolSettings->Color = FMath::Lerp(From.Color, To.Color, Alpha);
+	ToolSettings->ColorTemperature = FMath::Lerp(From.ColorTemperature, To.ColorTemperature, Alpha);
+
+	ApplyLightParams();
+	InvalidateViewport();
+
+	if (Alpha >= 1.0f)
+	{
+		FinishPresetTransition();
+	}
+}
+
+void FBrightEyeManagerImp::FinishPresetTransition()
+{
+	PresetTransition.bIsActive = false;
+
+	if (BrightEyePanel.IsValid())
+	{
+		BrightEyePanel->RefreshPanel();
+	}
+
+	ForceViewportRedraw();
+	ResetLightModificationState();
+}
+
+void FBrightEyeManagerImp::PreloadPresetProfiles()
+{
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+	if (!IsValid(ToolSettings)) { return; }
+
+	TArray<FSoftObjectPath> ProfilePaths;
+	for (const FBELightPreset& Preset : ToolSettings->LightPresets)
+	{
+		if (Preset.LightProfile.ToSoftObjectPath().IsValid())
+		{
+			ProfilePaths.AddUnique(Preset.LightProfile.ToSoftObjectPath());
+		}
+	}
+
+	if (PresetProfileHandle.IsValid())
+	{
+		PresetProfileHandle->ReleaseHandle();
+		PresetProfileHandle.Reset();
+	}
+
+	// The handle keeps the profiles loaded for as long as the presets use them.
+	if (ProfilePaths.Num() > 0)
+	{
+		PresetProfileHandle = PresetStreamableManager.RequestAsyncLoad(ProfilePaths);
+	}
+}
+
+#pragma endregion LightPresets
+
+#pragma region LightRig
+
+void FBrightEyeManagerImp::ApplyLightRig()
+{
+	UBESettings* ToolSettings = UBESettings::GetInstance();
+	if (!IsValid(ToolSettings)) { return; }
+
+	const FBERigPreset* Preset = ToolSettings->GetActiveRigPreset();
+	LightRig.Apply(Preset ? Preset->Lights : TArray<FBERigLight>());
+
+	ForceViewportRedraw();
+}
+
+void FBrightEyeManagerImp::OnRigPresetCycled()
+{
+	UBESettings* ToolSettings = UBESettings::GetInstance();
+	if (!IsValid(ToolSettings) || ToolSettings->RigPresets.Num() == 0) { return; }
+
+	ToolSettings->ActiveRigPreset = (ToolSettings->ActiveRigPreset + 1) % ToolSettings->RigPresets.Num();
+
+	ApplyLightRig();
+	ResetLightModificationState();
+}
+
+void FBrightEyeManagerImp::OnRigLightToggled(const int32 InIndex)
+{
+	UBESettings* ToolSettings = UBESettings::GetInstance();
+	FBERigPreset* Preset = IsValid(ToolSettings) ? ToolSettings->GetActiveRigPreset() : nullptr;
+	if (!Preset || !Preset->Lights.IsValidIndex(InIndex)) { return; }
+
+	Preset->Lights[InIndex].bEnabled = !Preset->Lights[InIndex].bEnabled;
+
+	ApplyLightRig();
+	ResetLightModificationState();
+}
+
+bool FBrightEyeManagerImp::IsRigLightEnabled(const int32 InIndex) const
+{
+	UBESettings* ToolSettings = UBESettings::GetInstance();
+	const FBERigPreset* Preset = IsValid(ToolSettings) ? ToolSettings->GetActiveRigPreset() : nullptr;
+
+	return Preset && Preset->Lights.IsValidIndex(InIndex) && Preset->Lights[InIndex].bEnabled;
+}
+
+int32 FBrightEyeManagerImp::GetRigLightCount() const
+{
+	UBESettings* ToolSettings = UBESettings::GetInstance();
+	const FBERigPreset* Preset = IsValid(ToolSettings) ? ToolSettings->GetActiveRigPreset() : nullptr;
+
+	return Preset ? FMath::Min(Preset->Lights.Num(), FBELightRig::MaxLights) : 0;
+}
+
+FText FBrightEyeManagerImp::GetRigSummary() const
+{
+	UBESettings* ToolSettings = UBESettings::GetInstance();
+	const FBERigPreset* Preset = IsValid(ToolSettings) ? ToolSettings->GetActiveRigPreset() : nullptr;
+
+	return FText::FromString(Preset ? FString::Printf(TEXT("Rig: %s"), *Preset->Name) : TEXT("Rig: -"));
+}
+
+#pragma endregion LightRig
+
+#pragma region LightCost
+
+void FBrightEyeManagerImp::UpdateLightCost(const float& InDeltaTime)
+{
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+	if (!IsValid(ToolSettings)) { return; }
+
+	if (!ToolSettings->bEstimateLightCost || !ToolSettings->bCapLightCost)
+	{
+		ClearLightCostCap();
+	}
+
+	if (!ToolSettings->bEstimateLightCost || !IsValid(BrightEyeComponent) || !BrightEyeComponent->IsVisible()) { return; }
+
+	UWorld* EditorWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	const int32 PrimitiveBudget = ToolSettings->bCapLightCost ? ToolSettings->LightCostPrimitiveBudget : 0;
+
+	const bool bHasNewResult = LightCostEstimator.Tick(InDeltaTime, EditorWorld, BrightEyeComponent, GetConfiguredAttenuationRadius(), PrimitiveBudget);
+
+	RefreshSceneDelegates();
+
+	if (!bHasNewResult || !ToolSettings->bCapLightCost) { return; }
+
+	const FBELightCostResult& CostResult = LightCostEstimator.GetResult();
+	if (!CostResult.bIsCapped)
+	{
+		ClearLightCostCap();
+		return;
+	}
+
+	if (!bIsLightCostCapped || !FMath::IsNearlyEqual(CostResult.BudgetRadius, CappedAttenuationRadius))
+	{
+		bIsLightCostCapped = true;
+		CappedAttenuationRadius = CostResult.BudgetRadius;
+		UpdateDistance();
+		InvalidateViewport();
+	}
+}
+
+void FBrightEyeManagerImp::ClearLightCostCap()
+{
+	if (!bIsLightCostCapped) { return; }
+
+	bIsLightCostCapped = false;
+	CappedAttenuationRadius = 0.0f;
+	UpdateDistance();
+	InvalidateViewport();
+}
+
+FText FBrightEyeManagerImp::BuildLightCostSummary() const
+{
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+	if (!IsValid(ToolSettings) || !ToolSettings->bEstimateLightCost)
+	{
+		return FText::GetEmpty();
+	}
+
+	const FBELightCostResult& CostResult = LightCostEstimator.GetResult();
+	if (!CostResult.bIsValid)
+	{
+		return FText::FromString(TEXT("Light cost: -"));
+	}
+
+	// A capped light only pays for what it still reaches, so those counts are shown instead of the full reach.
+	const bool bIsCapped = bIsLightCostCapped && CostResult.bIsCapped;
+	const int32 PrimitiveCount = bIsCapped ? CostResult.CappedPrimitiveCount : CostResult.PrimitiveCount;
+	const int64 TriangleCount = bIsCapped ? CostResult.CappedTriangleCount : CostResult.TriangleCount;
+
+	FString Summary = FString::Printf(TEXT("Touches %s primitives, %s triangles"),
+		*FText::AsNumber(PrimitiveCount).ToString(), *FText::AsNumber(TriangleCount).ToString());
+
+	if (bIsCapped)
+	{
+		Summary += FString::Printf(TEXT(" (capped %.0f)"), CappedAttenuationRadius);
+	}
+
+	return FText::FromString(Summary);
+}
+
+#pragma endregion LightCost
+
+#pragma region FrameBudget
+
+void FBrightEyeManagerImp::UpdateFrameBudget(const float& InDeltaTime, const double InTickMilliseconds)
+{
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+	const float BudgetMilliseconds = IsValid(ToolSettings) ? ToolSettings->FrameBudgetMs : 0.0f;
+
+	if (BudgetGovernor.Update(InTickMilliseconds, InDeltaTime, BudgetMilliseconds))
+	{
+		ApplyDegradationLevel();
+	}
+
+	SET_FLOAT_STAT(STAT_BrightEyeTickCost, BudgetGovernor.GetSmoothedCost());
+	SET_DWORD_STAT(STAT_BrightEyeDegradationLevel, static_cast<uint32>(BudgetGovernor.GetLevel()));
+}
+
+void FBrightEyeManagerImp::ApplyDegradationLevel()
+{
+	FGeometryUtils::SetTraceInterval(BudgetGovernor.IsAtLeast(EBEDegradationLevel::ReducedTraceRate) ? DEGRADED_TRACE_INTERVAL : 1);
+
+	LightSmoother.SetSubstepStride(BudgetGovernor.IsAtLeast(EBEDegradationLevel::SkipSmoothingSubsteps) ? DEGRADED_SUBSTEP_STRIDE : 1);
+}
+
+void FBrightEyeManagerImp::RefreshPanelSummaries(const float& InDeltaTime)
+{
+	PanelRefreshTimer += InDeltaTime;
+
+	if (!BrightEyePanel.IsValid() || PanelRefreshTimer < PANEL_REFRESH_INTERVAL || BudgetGovernor.IsAtLeast(EBEDegradationLevel::DeferPanelAndConfig)) { return; }
+
+	PanelRefreshTimer = 0.0f;
+
+	LightStampSummary = BuildLightStampSummary();
+	LightCostSummary = BuildLightCostSummary();
+}
+
+#pragma endregion FrameBudget
+
+#pragma region DarkSpots
+
+void FBrightEyeManagerImp::OnToggleDarkSpots()
+{
+	if (!bIsAnyControlKeyPressed) { return; }
+
+	TSharedPtr<SLevelViewport> ViewportPtr = ActiveViewport.Pin();
+	if (!ViewportPtr.IsValid() || !ViewportPtr->GetActiveViewport()->HasFocus()) { return; }
+
+	// The grid is built in the background and drawn once it is ready.
+	if (DarkSpotFinder.IsBuilt())
+	{
+		ClearDarkSpots();
+	}
+	else
+	{
+		BuildDarkSpots();
+	}
+
+	InvalidateViewport();
+}
+
+void FBrightEyeManagerImp::OnAimAtDarkestSpot()
+{
+	if (!bIsAnyControlKeyPressed) { return; }
+
+	TSharedPtr<SLevelViewport> ViewportPtr = ActiveViewport.Pin();
+	if (!ViewportPtr.IsValid() || !ViewportPtr->GetActiveViewport()->HasFocus()) { return; }
+
+	if (PinnedAimLocation.IsSet() || bIsDarkestSpotAimPending)
+	{
+		PinnedAimLocation.Reset();
+		bIsDarkestSpotAimPending = false;
+		InvalidateViewport();
+		return;
+	}
+
+	if (!DarkSpotFinder.IsBuilt() && !BuildDarkSpots()) { return; }
+
+	// While the grid is still being evaluated, the light is aimed as soon as it settles.
+	if (!DarkSpotFinder.IsReady())
+	{
+		bIsDarkestSpotAimPending = true;
+		return;
+	}
+
+	AimAtDarkestSpot();
+}
+
+void FBrightEyeManagerImp::AimAtDarkestSpot()
+{
+	TSharedPtr<SLevelViewport> ViewportPtr = ActiveViewport.Pin();
+	if (!ViewportPtr.IsValid()) { return; }
+
+	FConvexVolume ViewFrustum;
+	const bool bUseFrustum = FGeometryUtils::GetViewFrustum(&ViewportPtr->GetLevelViewportClient(), ViewFrustum);
+
+	FVector DarkestLocation;
+	if (DarkSpotFinder.FindDarkestCell(bUseFrustum ? &ViewFrustum : nullptr, DarkestLocation))
+	{
+		if (!IsValid(BrightEyeActor))
+		{
+			CreateBrightEyeLight();
+		}
+
+		PinnedAimLocation = DarkestLocation;
+		SetLightVisibility(true);
+	}
+}
+
+bool FBrightEyeManagerImp::BuildDarkSpots()
+{
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+	TSharedPtr<SLevelViewport> ViewportPtr = ActiveViewport.Pin();
+	UWorld* EditorWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!IsValid(ToolSettings) || !ViewportPtr.IsValid() || !IsValid(EditorWorld)) { return false; }
+
+	if (!IsValid(BrightEyeActor))
+	{
+		CreateBrightEyeLight();
+	}
+
+	FBox GridBounds(ForceInit);
+	if (ToolSettings->DarkSpotRegion == EBEDarkSpotRegion::LevelBounds)
+	{
+		GridBounds = ALevelBounds::CalculateLevelBounds(EditorWorld->PersistentLevel);
+	}
+	else
+	{
+		FGeometryUtils::GetViewBounds(&ViewportPtr->GetLevelViewportClient(), ToolSettings->DarkSpotViewDistance, GridBounds);
+	}
+
+	DarkSpotFinder.Build(EditorWorld, GridBounds, ToolSettings->DarkSpotResolution, ToolSettings->bDarkSpotOcclusion, BrightEyeActor);
+
+	if (!DarkSpotFinder.IsBuilt()) { return false; }
+
+	RefreshSceneDelegates();
+	return true;
+}
+
+void FBrightEyeManagerImp::ClearDarkSpots()
+{
+	DarkSpotFinder.Reset();
+	PinnedAimLocation.Reset();
+	bIsDarkestSpotAimPending = false;
+
+	RefreshSceneDelegates();
+
+	if (IsValid(DarkSpotLineBatcher))
+	{
+		DarkSpotLineBatcher->Flush();
+	}
+}
+
+void FBrightEyeManagerImp::RefreshDarkSpots()
+{
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+	if (!IsValid(ToolSettings)) { return; }
+
+	// Occlusion traces run on the game thread, so they get a smaller share while the tick is over budget.
+	const int32 TraceBudget = BudgetGovernor.IsAtLeast(EBEDegradationLevel::ReducedTraceRate)
+		? ToolSettings->DarkSpotTracesPerFrame / DEGRADED_TRACE_INTERVAL
+		: ToolSettings->DarkSpotTracesPerFrame;
+
+	if (!DarkSpotFinder.Tick(TraceBudget)) { return; }
+
+	DrawDarkSpots();
+
+	if (bIsDarkestSpotAimPending && DarkSpotFinder.IsReady())
+	{
+		bIsDarkestSpotAimPending = false;
+		AimAtDarkestSpot();
+	}
+
+	InvalidateViewport();
+}
+
+void FBrightEyeManagerImp::DrawDarkSpots()
+{
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+	if (!IsValid(ToolSettings) || !IsValid(BrightEyeActor)) { return; }
+
+	if (!IsValid(DarkSpotLineBatcher))
+	{
+		DarkSpotLineBatcher = NewObject<ULineBatchComponent>(BrightEyeActor, NAME_None, RF_Transient);
+		BrightEyeActor->RegisterHelperComponent(DarkSpotLineBatcher);
+	}
+
+	DarkSpotFinder.DrawUnderLitCells(DarkSpotLineBatcher, ToolSettings->DarkSpotThreshold);
+}
+
+void FBrightEyeManagerImp::RefreshSceneDelegates()
+{
+	// Scene edits are only listened to while the dark spot grid or the light cost snapshot has something to keep current.
+	if (DarkSpotFinder.IsBuilt() || LightCostEstimator.HasSnapshot())
+	{
+		BindSceneDelegates();
+	}
+	else
+	{
+		UnbindSceneDelegates();
+	}
+}
+
+void FBrightEyeManagerImp::BindSceneDelegates()
+{
+	if (bAreSceneDelegatesBound || !GEngine) { return; }
+
+	FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FBrightEyeManagerImp::OnObjectPropertyChanged);
+	GEngine->OnActorMoved().AddRaw(this, &FBrightEyeManagerImp::OnLevelActorChanged);
+	GEngine->OnLevelActorAdded().AddRaw(this, &FBrightEyeManagerImp::OnLevelActorChanged);
+	GEngine->OnLevelActorDeleted().AddRaw(this, &FBrightEyeManagerImp::OnLevelActorDeleted);
+
+	bAreSceneDelegatesBound = true;
+	++FBrightEyeLiveCounts::SceneDelegateBindings;
+}
+
+void FBrightEyeManagerImp::UnbindSceneDelegates()
+{
+	if (!bAreSceneDelegatesBound) { return; }
+
+	FCoreUObjectDelegates::OnObjectPropertyChanged.RemoveAll(this);
+
+	if (GEngine)
+	{
+		GEngine->OnActorMoved().RemoveAll(this);
+		GEngine->OnLevelActorAdded().RemoveAll(this);
+		GEngine->OnLevelActorDeleted().RemoveAll(this);
+	}
+
+	bAreSceneDelegatesBound = false;
+	--FBrightEyeLiveCounts::SceneDelegateBindings;
+}
+
+void FBrightEyeManagerImp::OnObjectPropertyChanged(UObject* InObject, FPropertyChangedEvent& InPropertyChangedEvent)
+{
+	if (const ULightComponent* LightComponent = Cast<ULightComponent>(InObject))
+	{
+		DarkSpotFinder.MarkLightDirty(LightComponent);
+	}
+	else if (const AActor* Actor = Cast<AActor>(InObject))
+	{
+		DarkSpotFinder.MarkActorDirty(Actor);
+		LightCostEstimator.MarkActorDirty(Actor);
+	}
+	else if (const UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(InObject))
+	{
+		LightCostEstimator.MarkActorDirty(PrimitiveComponent->GetOwner());
+	}
+}
+
+void FBrightEyeManagerImp::OnLevelActorChanged(AActor* InActor)
+{
+	DarkSpotFinder.MarkActorDirty(InActor);
+	LightCostEstimator.MarkActorDirty(InActor);
+}
+
+void FBrightEyeManagerImp::OnLevelActorDeleted(AActor* InActor)
+{
+	DarkSpotFinder.RemoveActorLights(InActor);
+	LightCostEstimator.RemoveActor(InActor);
+}
+
+#pragma endregion DarkSpots
+
+#pragma region LightOverlay
+
+void FBrightEyeManagerImp::OnToggleLightOverlay()
+{
+	if (!bIsAnyControlKeyPressed) { return; }
+
+	UBESettings* ToolSettings = UBESettings::GetInstance();
+	TSharedPtr<SLevelViewport> ViewportPtr = ActiveViewport.Pin();
+	if (!IsValid(ToolSettings) || !ViewportPtr.IsValid() || !ViewportPtr->GetActiveViewport()->HasFocus()) { return; }
+
+	ToolSettings->bShowLightOverlay = !ToolSettings->bShowLightOverlay;
+
+	ApplyLightOverlay();
+
+	InvalidateViewport();
+
+	ResetLightModificationState();
+}
+
+void FBrightEyeManagerImp::ApplyLightOverlay()
+{
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+
+	// The draw callback is only registered while the overlay is shown, so a hidden overlay costs nothing per frame.
+	LightOverlay.SetEnabled(IsValid(ToolSettings) && ToolSettings->bShowLightOverlay);
+}
+
+#pragma endregion LightOverlay
+
+
+void FBrightEyeManagerImp::OnPanelDragStarted()
+{
+	bIsDragging = true;
+	TryHideBrightEyePanel();
+}
+
+void FBrightEyeManagerImp::CheckForOutOfBoundDropping(const float& InDeltaTime)
+{
+	PanelDropTimer  += InDeltaTime;
+	if(PanelDropTimer  >= DROP_CHECK_TIME)
+	{
+		bCheckingForDrop = false;
+		if(bIsDragging)
+		{
+			OnPanelDragFinished(BEPanelLocation);
+			bIsDragging = false;
+		}
+	}
+}
+
+void FBrightEyeManagerImp::OnCoordsChanged(const FVector2D& InNewCoords)
+{
+	UBESettings* ToolSettings = UBESettings::GetInstance();
+
+	if (!ActiveViewport.IsValid() || !IsValid(ToolSettings)) { return; }
+
+	ToolSettings->LightViewOffset = InNewCoords * 100.0f;
+	
+	ForceViewportRedraw();
+
+	ResetLightModificationState();
+}
+
+void FBrightEyeManagerImp::OnPanelDragFinished(const FVector2D& InDropLocation)
+{
+	bIsDragging = false;
+	UpdateBrightEyePanelLocation(InDropLocation);
+	TryRevealBrightEyePanel();
+}
+
+void FBrightEyeManagerImp::CreateBrightEyeLight()
+{
+	UWorld* EditorWorld = GEditor->GetEditorWorldContext().World();
+	if (!EditorWorld) return;
+
+	BrightEyeActor = EditorWorld->SpawnActor<ABEBrightEyeActor>();
+	if (IsValid(BrightEyeActor))
+	{
+		BrightEyeActor->SetActorLabel(TEXT("Bright Eye Manager"));
+
+		BrightEyeActor->SetFlags(RF_Transient);
+
+		BrightEyeComponent = NewObject<USpotLightComponent>(BrightEyeActor);
+		if (!IsValid(BrightEyeComponent)) { return; }
+
+		BrightEyeActor->RegisterHelperComponent(BrightEyeComponent);
+		LightRig.Build(BrightEyeActor, BrightEyeComponent);
+		LightOverlay.SetLight(BrightEyeComponent);
+
+		const UBESettings* ToolSettings = UBESettings::GetInstance();
+		if (!IsValid(ToolSettings)) { return; }
+
+		BrightEyeComponent->SetInnerConeAngle(0);
+		BrightEyeComponent->SetCastShadows(false);
+
+		ResetBrightEyeRotation();
+
+		UpdateBrightEyeSpecs();
+
+		BrightEyeComponent->SetVisibility(false, true);
+		TArray<USceneComponent*> AttachedComponents;
+		BrightEyeComponent->GetChildrenComponents(true, AttachedComponents);
+
+		for (USceneComponent* Component : AttachedComponents)
+		{
+			if (UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(Component))
+			{
+				PrimitiveComponent->SetVisibility(false);
+			}
+		}
+
+		ApplyLightRig();
+
+		if (!PresetProfileHandle.IsValid())
+		{
+			PreloadPresetProfiles();
+		}
+	}
+}
+
+void FBrightEyeManagerImp::DestroyBrightLight()
+{
+	if (!IsValid(BrightEyeActor)) { return; }
+
+	StopFollowingViewOnRender();
+
+	BrightEyeActor->Destroy();
+	BrightEyeActor = nullptr;
+	BrightEyeComponent = nullptr;
+	DarkSpotLineBatcher = nullptr;
+	LightRig.Reset();
+	LightOverlay.SetLight(nullptr);
+}
+
+
+
+void FBrightEyeManagerImp::UpdateLightTransformWithViewport(const float& InDeltaTime)
+{
+	TSharedPtr<FLevelEditorViewportClient> ViewportClient = StaticCastSharedPtr<FLevelEditorViewportClient>(ActiveViewport.Pin()->GetViewportClient());
+
+	if (ViewportClient.IsValid() && IsValid(BrightEyeComponent) && IsValid(LightRig.GetRoot()) && UBESettings::GetInstance())
+	{
+		FVector LightLocation = FGeometryUtils::GetLightLocationFromView(ViewportClient->GetViewLocation(), ViewportClient->GetViewRotation(), UBESettings::GetInstance()->LightViewOffset);
+		if(bIsAimLighting)
+		{
+			FVector MouseHitLocation;
+			FGeometryUtils::GetHitLocationFromCameraAndMouse(MouseHitLocation);
 
 			FRotator LookRotation = (MouseHitLocation - LightLocation).Rotation();
 			
 			float DelaySpeed = FMath::Lerp(MIN_DELAY_SPEED, MAX_DELAY_SPEED,UBESettings::GetInstance()->RotationDelayFactor);
-			BrightEyeRotation = FMath::RInterpTo(BrightEyeRotation, LookRotation, InDeltaTime, DelaySpeed);
+			const FQuat SmoothedRotation = LightSmoother.Update(LookRotation.Quaternion(), InDeltaTime, DelaySpeedToHalfLife(DelaySpeed), UBESettings::GetInstance()->bPredictLightMotion);
 			
-			BrightEyeComponent->SetWorldLocation(LightLocation);
-			BrightEyeComponent->SetWorldRotation(BrightEyeRotation);
+			LightRig.GetRoot()->SetWorldLocationAndRotation(LightLocation, SmoothedRotation);
 
 			InvalidateViewport();
 		}
 		else
 		{
 			FRotator LightRotation = ViewportClient->GetViewRotation();
-			if(!UBESettings::GetInstance()->LightViewOffset.IsZero())
+			if(PinnedAimLocation.IsSet())
+			{
+				LightRotation = (PinnedAimLocation.GetValue() - LightLocation).Rotation();
+			}
+			else if(!UBESettings::GetInstance()->LightViewOffset.IsZero())
 			{
 				LightRotation = FGeometryUtils::AdjustLightRotationFromTrace(ViewportClient->GetViewLocation(),ViewportClient->GetViewRotation(), LightLocation);
 			}
@@ -796,17 +1744,17 @@ void FBrightEyeManagerImp::UpdateLightTransformWithViewport(const float& InDelta
 			
 			if (!UBESettings::GetInstance()->bSmoothLightRotation)
 			{
-				BrightEyeComponent->SetWorldLocation(LightLocation);
+				LightRig.GetRoot()->SetWorldLocationAndRotation(LightLocation, LightRotation);
 
-				BrightEyeComponent->SetWorldRotation(LightRotation);
+				// Keeps aim mode easing out from where the light actually is.
+				LightSmoother.Reset(LightRotation.Quaternion());
 			}
 			else
 			{
 				float DelaySpeed = FMath::Lerp(MAX_DELAY_SPEED, MIN_DELAY_SPEED,UBESettings::GetInstance()->RotationDelayFactor);
-				BrightEyeRotation = FMath::RInterpTo(BrightEyeRotation, LightRotation, InDeltaTime, DelaySpeed);
+				const FQuat SmoothedRotation = LightSmoother.Update(LightRotation.Quaternion(), InDeltaTime, DelaySpeedToHalfLife(DelaySpeed), UBESettings::GetInstance()->bPredictLightMotion);
 			
-				BrightEyeComponent->SetWorldLocation(LightLocation);
-				BrightEyeComponent->SetWorldRotation(BrightEyeRotation);
+				LightRig.GetRoot()->SetWorldLocationAndRotation(LightLocation, SmoothedRotation);
 
 				InvalidateViewport();
 			}
@@ -814,10 +1762,62 @@ void FBrightEyeManagerImp::UpdateLightTransformWithViewport(const float& InDelta
 	}
 }
 
-void FBrightEyeManagerImp::InitializePanel()
+bool FBrightEyeManagerImp::TryFollowViewOnRender()
+{
+	const UBESettings* ToolSettings = UBESettings::GetInstance();
+
+	// Only the fixed pose can be taken from the view alone; aiming, smoothing and pinning need the tick.
+	const bool bCanFollowView = IsValid(ToolSettings) && ToolSettings->bFollowViewOnRender && !bIsAimLighting && !ToolSettings->bSmoothLightRotation && !PinnedAimLocation.IsSet();
+
+	if (!bCanFollowView || !FBEViewExtension::CanExtendViews())
+	{
+		StopFollowingViewOnRender();
+		return false;
+	}
+
+	// Created lazily, since the engine's view extension registry does not exist yet when the module starts.
+	if (!ViewExtension.IsValid())
+	{
+		ViewExtension = FSceneViewExtensions::NewExtension<FBEViewExtension>();
+	}
+
+	TSharedPtr<FLevelEditorViewportClient> ViewportClient = StaticCastSharedPtr<FLevelEditorViewportClient>(ActiveViewport.Pin()->GetViewportClient());
+	if (!ViewportClient.IsValid() || !ViewportClient->Viewport)
+	{
+		StopFollowingViewOnRender();
+		return false;
+	}
+
+	// The target is only pushed when the viewport, the offset or the light itself changed.
+	if (!ViewExtension->IsFollowing(LightRig.GetRoot(), ViewportClient->Viewport, ToolSettings->LightViewOffset))
+	{
+		ViewExtension->SetFollowTarget(LightRig.GetRoot(), ViewportClient->Viewport, ToolSettings->LightViewOffset);
+	}
+
+	bIsFollowingViewOnRender = true;
+	return true;
+}
+
+void FBrightEyeManagerImp::StopFollowingViewOnRender()
 {
-	RefreshColorPicker();
+	if (!bIsFollowingViewOnRender) { return; }
+
+	bIsFollowingViewOnRender = false;
+
+	if (ViewExtension.IsValid())
+	{
+		ViewExtension->ClearFollowTarget();
+	}
+
+	// Keeps aim mode easing out from where the light actually is.
+	if (IsValid(BrightEyeComponent))
+	{
+		LightSmoother.Reset(BrightEyeComponent->GetComponentQuat());
+	}
+}
 
+void FBrightEyeManagerImp::InitializePanel()
+{
 	InitializePanelParams();
 }
 
@@ -833,25 +1833,6 @@ void FBrightEyeManagerImp::ResetPanelLocation()
 	UpdateBrightEyePanelLocation(BEPanelLocation);
 }
 
-void FBrightEyeManagerImp::RefreshColorPicker()
-{
-	if (BrightEyePanel.IsValid())
-	{
-		if (const UBESettings* ToolSettings = UBESettings::GetInstance())
-		{
-			if (IsValid(BrightEyePanel->GetColorPicker()))
-			{
-				if (!BrightEyePanel->GetColorPicker()->GetOnParamChangedDelegate().IsBound())
-				{
-					BrightEyePanel->GetColorPicker()->GetOnParamChangedDelegate().BindRaw(this, &FBrightEyeManagerImp::OnColorParamChanged);
-				}
-
-				BrightEyePanel->GetColorPicker()->InitializeColor(ToolSettings->Color);
-			}
-		}
-	}
-}
-
 void FBrightEyeManagerImp::InitializePanelParams() const
 {
 	if (BrightEyePanel.IsValid())
@@ -871,6 +1852,10 @@ void FBrightEyeManagerImp::CreateBrightEyePanel()
 	{
 		ResetPanelLocation();
 
+		// The panel reads cached summaries, so they are filled before its first paint.
+		LightStampSummary = BuildLightStampSummary();
+		LightCostSummary = BuildLightCostSummary();
+
 		SAssignNew(BrightEyePanelParent, SHorizontalBox)
 		+ SHorizontalBox::Slot()
 		.FillWidth(1.0f)
@@ -879,14 +1864,27 @@ void FBrightEyeManagerImp::CreateBrightEyePanel()
 		.Padding(TAttribute<FMargin>(this, &FBrightEyeManagerImp::GetBrightEyePanelPadding))
 		[
 			SAssignNew(BrightEyePanel, SBrightEyePanel)
-			.Owner(BrightEyeActor)
 			.OnPanelDragStarted_Raw(this, &FBrightEyeManagerImp::OnPanelDragStarted)
 			.OnPanelDragFinished_Raw(this, &FBrightEyeManagerImp::OnPanelDragFinished)
 			.OnBrightnessChanged_Raw(this, &FBrightEyeManagerImp::OnScalarParamChanged, EBEScalarParamType::Brightness)
 			.OnRadiusChanged_Raw(this, &FBrightEyeManagerImp::OnScalarParamChanged, EBEScalarParamType::Radius)
 			.OnDistanceChanged_Raw(this, &FBrightEyeManagerImp::OnScalarParamChanged, EBEScalarParamType::Distance)
 			.OnSmoothRotationStateChanged_Raw(this, &FBrightEyeManagerImp::OnSmoothRotationToggled)
+			.OnColorChanged_Raw(this, &FBrightEyeManagerImp::OnColorParamChanged)
+			.OnTemperatureChanged_Raw(this, &FBrightEyeManagerImp::OnTemperatureParamChanged)
 			.OnCoordsChanged_Raw(this,&FBrightEyeManagerImp::OnCoordsChanged)
+			.RigSummary_Raw(this, &FBrightEyeManagerImp::GetRigSummary)
+			.RigLightCount_Raw(this, &FBrightEyeManagerImp::GetRigLightCount)
+			.IsRigLightEnabled_Raw(this, &FBrightEyeManagerImp::IsRigLightEnabled)
+			.OnRigLightToggled_Raw(this, &FBrightEyeManagerImp::OnRigLightToggled)
+			.OnRigPresetCycled_Raw(this, &FBrightEyeManagerImp::OnRigPresetCycled)
+			.LightCostSummary_Raw(this, &FBrightEyeManagerImp::GetLightCostSummary)
+			.StampSummary_Raw(this, &FBrightEyeManagerImp::GetLightStampSummary)
+			.OnStampsToggled_Raw(this, &FBrightEyeManagerImp::OnLightStampsToggled)
+			.OnStampsRecolored_Raw(this, &FBrightEyeManagerImp::OnLightStampsRecolored)
+			.OnStampsScaled_Raw(this, &FBrightEyeManagerImp::OnLightStampsScaled)
+			.OnStampsCleared_Raw(this, &FBrightEyeManagerImp::ClearLightStamps)
+			.OnStampsConverted_Raw(this, &FBrightEyeManagerImp::ConvertLightStamps)
 			.Cursor(EMouseCursor::Type::Default)
 		];
 
@@ -921,15 +1919,17 @@ FMargin FBrightEyeManagerImp::GetBrightEyePanelPadding() const
 
 void FBrightEyeManagerImp::DestroyBrightEyePanel()
 {
-	if (!BrightEyePanelParent.IsValid() || !ActiveViewport.Pin().IsValid()) { return; }
+	if (!BrightEyePanelParent.IsValid()) { return; }
 
 	if (ActiveViewport.Pin().IsValid())
 	{
 		ActiveViewport.Pin()->RemoveOverlayWidget(BrightEyePanelParent.ToSharedRef());
-		bIsPanelOnWindow = false;
-		BrightEyePanelParent.Reset();
-		BrightEyePanel.Reset();
 	}
+
+	// Released even when the viewport is already gone, so the panel is not kept alive until the next one replaces it.
+	bIsPanelOnWindow = false;
+	BrightEyePanelParent.Reset();
+	BrightEyePanel.Reset();
 }
 
 void FBrightEyeManagerImp::TryRevealBrightEyePanel()
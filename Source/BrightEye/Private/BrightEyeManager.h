@@ -5,12 +5,23 @@
 
 #include "CoreMinimal.h"
 #include "UnrealEdMisc.h"
+#include "Engine/StreamableManager.h"
+#include "Data/LightRig.h"
+#include "Data/LightStamps.h"
+#include "Helpers/DarkSpotFinder.h"
+#include "Helpers/FrameBudgetGovernor.h"
+#include "Helpers/LightCostEstimator.h"
+#include "Helpers/LightOverlay.h"
+#include "Helpers/LightSmoother.h"
 
 class SBrightEyePanel;
 class UBESettings;
 class SBEControlPanel;
 class USpotLightComponent;
+class ABEBrightEyeActor;
 class SLevelViewport;
+class ULineBatchComponent;
+class FBEViewExtension;
 
 enum class EBEScalarParamType
 {
@@ -24,6 +35,9 @@ enum class EBEScalarParamType
  */
 class FBrightEyeManagerImp : public TSharedFromThis<FBrightEyeManagerImp>
 {
+    // Drives the private lifecycle paths in a loop and checks that nothing is left behind.
+    friend class FBrightEyeLifecycleSoakTest;
+
 public:
     // Initialization and Shutdown
     void Initialize();
@@ -31,7 +45,7 @@ public:
 
     // Delegate setup
     void SetupDelegates();
-    void RemoveDelegates() const;
+    void RemoveDelegates();
 
 private:
     void HandleBeginPIE(bool bIsSimulating);
@@ -49,15 +63,81 @@ private:
     void CreateBrightEyeLight();
     void DestroyBrightLight();
     void UpdateLightTransformWithViewport(const float& InDeltaTime);
+    bool TryFollowViewOnRender();
+    void StopFollowingViewOnRender();
     void UpdateBrightEyeSpecs() const;
     void UpdateBrightness() const;
+    void ApplyLightParams() const;
+    static float ComputeIntensity();
+    static FLinearColor ComputeLightColor();
+    static float ComputeOuterConeAngle();
+    float GetEffectiveAttenuationRadius() const;
     void UpdateRadius() const;
     void UpdateDistance() const;
+    static float GetConfiguredAttenuationRadius();
     void UpdateColor() const;
     void UpdateLightProfile() const;
     void UpdateLightViewOffsetOnPanel() const;
     void ResetBrightEyeRotation();
+
+    // Light stamp management
+    void OnStampBrightEye();
+    void OnClearLightStamps();
+    void OnConvertLightStamps();
+    void ClearLightStamps();
+    void ConvertLightStamps();
+    void OnLightStampsToggled();
+    void OnLightStampsRecolored();
+    void OnLightStampsScaled(float InScale);
+    void CullLightStamps(const float& InDeltaTime);
+    FText BuildLightStampSummary() const;
+    FText GetLightStampSummary() const { return LightStampSummary; }
+
+    // Light presets
+    void OnApplyPreset(int32 InIndex);
+    void ApplyPreset(int32 InIndex);
+    void AdvancePresetTransition(const float& InDeltaTime);
+    void FinishPresetTransition();
+    void PreloadPresetProfiles();
+
+    // Light rig management
+    void ApplyLightRig();
+    void OnRigPresetCycled();
+    void OnRigLightToggled(int32 InIndex);
+    bool IsRigLightEnabled(int32 InIndex) const;
+    int32 GetRigLightCount() const;
+    FText GetRigSummary() const;
+
+    // Dark spot management
+    void OnToggleDarkSpots();
+    void OnAimAtDarkestSpot();
+    void AimAtDarkestSpot();
+    bool BuildDarkSpots();
+    void ClearDarkSpots();
+    void RefreshDarkSpots();
+    void DrawDarkSpots();
+    void RefreshSceneDelegates();
+    void BindSceneDelegates();
+    void UnbindSceneDelegates();
+    void OnObjectPropertyChanged(UObject* InObject, FPropertyChangedEvent& InPropertyChangedEvent);
+    void OnLevelActorChanged(AActor* InActor);
+    void OnLevelActorDeleted(AActor* InActor);
+
+    // Light overlay
+    void OnToggleLightOverlay();
+    void ApplyLightOverlay();
     
+    // Light cost estimation
+    void UpdateLightCost(const float& InDeltaTime);
+    void ClearLightCostCap();
+    FText BuildLightCostSummary() const;
+    FText GetLightCostSummary() const { return LightCostSummary; }
+
+    // Frame budget
+    void UpdateFrameBudget(const float& InDeltaTime, double InTickMilliseconds);
+    void ApplyDegradationLevel();
+    void RefreshPanelSummaries(const float& InDeltaTime);
+
     // Bright Eye Panel management
     void InitializePanel();
     void CreateBrightEyePanel();
@@ -67,15 +147,19 @@ private:
     void UpdateBrightEyePanelLocation(FVector2D InLocation);
     FMargin GetBrightEyePanelPadding() const;
     void ResetPanelLocation();
-    void RefreshColorPicker();
     void InitializePanelParams() const;
 
     // Scalar and color parameter changes
     void OnScalarParamChanged(const float& InNewParam, EBEScalarParamType InParamType);
+    void ApplyScalarParam(float InNewParam, EBEScalarParamType InParamType);
+    bool HandleParamWheel(const FModifierKeysState& InModifiers, float InNotches);
+    void FlushPendingScalarParams(const float& InDeltaTime);
     void OnColorParamChanged(const FLinearColor& InNewColor);
+    void OnTemperatureParamChanged(const float& InNewTemperature);
+    void FlushPendingColorParams();
     void OnSmoothRotationToggled();
     void OnBrightEyeSettingsChangedOnEditorSettings(const FPropertyChangedEvent& InPropertyChangedEvent);
-    void OnResetBrightEyeSettings() const;
+    void OnResetBrightEyeSettings();
     
     // Panel dragging and drop checking
     void OnPanelDragStarted();
@@ -89,7 +173,6 @@ private:
     // Viewport management
     void OnActiveViewportChanged(TSharedPtr<IAssetViewport> OldViewport, TSharedPtr<IAssetViewport> NewViewport);
     void OnMapChanged(UWorld* World, EMapChangeType MapChangeType);
-    void OnActorSelectionChanged(const TArray<UObject*>& InActors, bool bIsSelected) const;
 
     // Light modification state
     void ResetLightModificationState();
@@ -106,12 +189,51 @@ private:
     static bool IsInPie();
 
     // Light-related variables
-    TObjectPtr<AActor> BrightEyeActor;
+    TObjectPtr<ABEBrightEyeActor> BrightEyeActor;
     TObjectPtr<USpotLightComponent> BrightEyeComponent;
-    FRotator BrightEyeRotation = FRotator();
+    FBELightRig LightRig;
+    FBELightSmoother LightSmoother;
+    TSharedPtr<FBEViewExtension, ESPMode::ThreadSafe> ViewExtension;
+    bool bIsFollowingViewOnRender = false;
+    FBELightOverlay LightOverlay;
     bool bLightSettingsModified = false;
     float TimeSinceLastModification = 0.0f;
 
+    // Light stamp variables
+    FBELightStamps LightStamps;
+    float StampCullTimer = 0.0f;
+
+    // Dark spot variables
+    FBEDarkSpotFinder DarkSpotFinder;
+    TObjectPtr<ULineBatchComponent> DarkSpotLineBatcher;
+    TOptional<FVector> PinnedAimLocation;
+    bool bIsDarkestSpotAimPending = false;
+    bool bAreSceneDelegatesBound = false;
+
+    // Light cost variables
+    FBELightCostEstimator LightCostEstimator;
+    bool bIsLightCostCapped = false;
+    float CappedAttenuationRadius = 0.0f;
+
+    // Light preset variables
+    struct FPresetTransition
+    {
+        FBELightPreset From;
+        FBELightPreset To;
+        float Elapsed = 0.0f;
+        float Duration = 0.0f;
+        bool bIsActive = false;
+    };
+    FPresetTransition PresetTransition;
+    FStreamableManager PresetStreamableManager;
+    TSharedPtr<FStreamableHandle> PresetProfileHandle;
+
+    // Frame budget variables
+    FBEFrameBudgetGovernor BudgetGovernor;
+    float PanelRefreshTimer = 0.0f;
+    FText LightStampSummary;
+    FText LightCostSummary;
+
     // Panel-related variables
     TSharedPtr<SWidget> BrightEyePanelParent;
     TSharedPtr<class SBrightEyePanel> BrightEyePanel;
@@ -123,6 +245,17 @@ private:
     bool bCheckingForDrop = false;
     bool bIsPanelOnWindow = false;
 
+    // Scalar changes from the panel and the wheel, applied once per tick
+    struct FPendingScalarParam
+    {
+        TOptional<float> Value;
+        float WheelNotches = 0.0f;
+    };
+    FPendingScalarParam PendingScalarParams[3];
+    float WheelSpeed = 0.0f;
+    TOptional<FLinearColor> PendingColor;
+    TOptional<float> PendingTemperature;
+
     // Input processing
     bool bIsAnyControlKeyPressed = true;
     TSharedPtr<class FBEInputPreProcessor> InputProcessor;
@@ -0,0 +1,48 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "BrightEyeActor.h"
+#include "Components/PrimitiveComponent.h"
+#include "System/BrightEyeStats.h"
+
+ABEBrightEyeActor::ABEBrightEyeActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	bIsEditorOnlyActor = true;
+
+#if WITH_EDITORONLY_DATA
+	bListedInSceneOutliner = false;
+#endif
+
+	// Counted until garbage collection, so helper actors that stay referenced after a map change show up in stat BrightEye.
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		INC_DWORD_STAT(STAT_BrightEyeLiveHelperActors);
+	}
+}
+
+void ABEBrightEyeActor::BeginDestroy()
+{
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		DEC_DWORD_STAT(STAT_BrightEyeLiveHelperActors);
+	}
+
+	Super::BeginDestroy();
+}
+
+void ABEBrightEyeActor::RegisterHelperComponent(USceneComponent* InComponent)
+{
+	if(!IsValid(InComponent)){return;}
+
+#if WITH_EDITORONLY_DATA
+	InComponent->bVisualizeComponent = false;
+#endif
+
+	if (UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(InComponent))
+	{
+		PrimitiveComponent->bSelectable = false;
+	}
+
+	InComponent->RegisterComponent();
+}
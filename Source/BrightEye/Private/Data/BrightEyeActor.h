@@ -0,0 +1,32 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "BrightEyeActor.generated.h"
+
+/**
+ * Transient helper actor that hosts the Bright Eye lights, stamps and debug lines.
+ * It cannot be selected, is not listed in the outliner, and its components draw no hit proxies,
+ * so the editor's selection and outliner paths never see it.
+ */
+UCLASS(Transient, NotPlaceable, NotBlueprintable)
+class BRIGHTEYE_API ABEBrightEyeActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ABEBrightEyeActor();
+
+	virtual void BeginDestroy() override;
+
+	// Registers a component created on this actor without an editor sprite or a selectable hit proxy.
+	void RegisterHelperComponent(USceneComponent* InComponent);
+
+#if WITH_EDITOR
+	virtual bool IsSelectable() const override { return false; }
+	virtual bool IsListedInSceneOutliner() const override { return false; }
+#endif
+};
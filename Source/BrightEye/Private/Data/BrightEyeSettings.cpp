@@ -27,12 +27,34 @@ void UBESettings::ResetToolSettings()
 	MaxBrightness = 500000;
 	MaxDistance = 50000;
 	Color = FLinearColor::White;
+	ColorTemperature = 6500.0f;
 	bActivateLightOnPress = false;
 	bHidePanelWhenIdle = false;
 	bSmoothLightRotation = false;
 	RotationDelayFactor = 0.4f;
+	bPredictLightMotion = true;
+	bFollowViewOnRender = true;
+	bWheelAdjustsParameters = true;
+	bShowLightOverlay = false;
+	FrameBudgetMs = 0.2f;
 	LightViewOffset = FVector2D();
 	LightProfile = nullptr;
+	LightPresets = FBELightPreset::MakeDefaults();
+	PresetTransitionDuration = 0.25f;
+	RigPresets = FBERigPreset::MakeDefaults();
+	ActiveRigPreset = 0;
+	MaxLightStamps = 512;
+	StampCullDistance = 30000;
+	bCullStampsOutsideView = true;
+	DarkSpotRegion = EBEDarkSpotRegion::ViewFrustum;
+	DarkSpotResolution = 24;
+	DarkSpotViewDistance = 10000;
+	DarkSpotThreshold = 1.0f;
+	bDarkSpotOcclusion = false;
+	DarkSpotTracesPerFrame = 1024;
+	bEstimateLightCost = true;
+	bCapLightCost = false;
+	LightCostPrimitiveBudget = 2000;
 	
 	if(OnResetBrightEyeSettings.IsBound())
 	{
@@ -40,6 +62,11 @@ void UBESettings::ResetToolSettings()
 	}
 }
 
+FBERigPreset* UBESettings::GetActiveRigPreset()
+{
+	return RigPresets.IsValidIndex(ActiveRigPreset) ? &RigPresets[ActiveRigPreset] : nullptr;
+}
+
 void UBESettings::OpenDocumentation() const
 {
 	const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("BrightEye"));
@@ -4,11 +4,20 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "LightPreset.h"
+#include "LightRig.h"
 #include "BrightEyeSettings.generated.h"
 
 DECLARE_DELEGATE_OneParam(FOnBrightLightSettingsChanged,const FPropertyChangedEvent&)
 DECLARE_DELEGATE(FOnResetBrightEyeSettings)
 
+UENUM()
+enum class EBEDarkSpotRegion : uint8
+{
+	ViewFrustum UMETA(DisplayName = "View Frustum"),
+	LevelBounds UMETA(DisplayName = "Level Bounds")
+};
+
 
 /**
  * Stores configuration settings for the Bright Eye tool, including brightness, radius, distance, and color parameters.
@@ -43,6 +52,9 @@ public:
 
 	UPROPERTY(EditAnywhere, config, Category = "Bright Eye",meta=(ToolTip = "Choose the color of the Bright Eye's light."))
 	FLinearColor Color = FLinearColor::White;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye", meta = (UIMin = 1700.0f, UIMax = 12000.0f, ClampMin = 1700.0f, ClampMax = 12000.0f, ToolTip = "Color temperature of the Bright Eye's light in Kelvin. 6500 is neutral; lower values are warmer and higher values are cooler."))
+	float ColorTemperature = 6500.0f;
 	
 	UPROPERTY(EditAnywhere, config, Category = "Bright Eye",meta=(ToolTip = "Toggle Bright Eye on/off with a key press, or hold to keep it on."))
 	bool bActivateLightOnPress = false;
@@ -56,12 +68,75 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = "Bright Eye", meta = (UIMin = 0.0, UIMax = 1.0, ClampMin = 0.0, ClampMax = 1.0, EditCondition="bSmoothLightRotation", ToolTip = "Set the delay factor for smoothing the camera rotation. Higher values result in more delay."))
 	float RotationDelayFactor = 0.4f;
 
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye", meta = (ToolTip = "Extrapolate the camera and cursor motion by one frame so the smoothing lag feels the same at any frame rate."))
+	bool bPredictLightMotion = true;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye", meta = (ToolTip = "Move the unsmoothed light from the viewport's own view setup so it never trails the camera. Falls back to the editor tick when views cannot be extended, for example under -nullrhi."))
+	bool bFollowViewOnRender = true;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye", meta = (ToolTip = "While the light is on, Alt + Mouse Wheel changes the brightness, Alt + Shift + Mouse Wheel the radius, and Alt + Ctrl + Mouse Wheel the distance. Trackpad scroll and pinch gestures work the same way."))
+	bool bWheelAdjustsParameters = true;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye", meta = (ToolTip = "Draw the light cone, its reach and the traced hit point over the level viewports. Toggle with Ctrl + Shift + O."))
+	bool bShowLightOverlay = false;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Performance", meta = (UIMin = 0.0f, UIMax = 2.0f, ClampMin = 0.0f, ToolTip = "Per-frame time budget of the Bright Eye tick in milliseconds. When it is exceeded, traces run less often, smoothing takes larger steps, and panel refresh and config saves are deferred until there is headroom again. Set to 0 to disable."))
+	float FrameBudgetMs = 0.2f;
+
 	UPROPERTY(EditAnywhere, config, Category = "Bright Eye", meta = (UIMin = -100.0f, UIMax = 100.0f, ClampMin = -100.0f, ClampMax = 100.0f, ToolTip = "Adjust the light offset relative to the camera's view, allowing fine-tuning of its position in the scene."))
 	FVector2D LightViewOffset = FVector2D(); 
 
 	UPROPERTY(EditAnywhere, config, Category = "Bright Eye", meta = (ToolTip = "Select a light profile (IES texture) to adjust the characteristics of the light's shape and distribution."))
 	TSoftObjectPtr<UTextureLightProfile> LightProfile = nullptr;
 
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Light Presets", meta = (TitleProperty = "Name", ToolTip = "Named light setups. Press Ctrl + Shift + 1 to 9 in the viewport to switch to the first nine."))
+	TArray<FBELightPreset> LightPresets = FBELightPreset::MakeDefaults();
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Light Presets", meta = (UIMin = 0.0f, UIMax = 2.0f, ClampMin = 0.0f, ToolTip = "Time in seconds the light takes to blend into a preset. Set to 0 to switch instantly."))
+	float PresetTransitionDuration = 0.25f;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Light Rig", meta = (TitleProperty = "Name", ToolTip = "Light rig presets. Each preset adds up to four lights around the main light, which all follow the camera together."))
+	TArray<FBERigPreset> RigPresets = FBERigPreset::MakeDefaults();
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Light Rig", meta = (ClampMin = 0, ToolTip = "Index of the rig preset in use."))
+	int32 ActiveRigPreset = 0;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Light Stamps", meta = (UIMin = 1, UIMax = 2000, ClampMin = 1, ClampMax = 2000, ToolTip = "Maximum number of light stamps that can be dropped before they are cleared or converted."))
+	int32 MaxLightStamps = 512;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Light Stamps", meta = (UIMin = 1000, UIMax = 200000, ClampMin = 1000, ToolTip = "Light stamps whose light volume is farther than this distance from the camera are culled."))
+	float StampCullDistance = 30000;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Light Stamps", meta = (ToolTip = "Cull light stamps whose light volume is outside the view frustum."))
+	bool bCullStampsOutsideView = true;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Dark Spots", meta = (ToolTip = "Region covered by the dark spot grid."))
+	EBEDarkSpotRegion DarkSpotRegion = EBEDarkSpotRegion::ViewFrustum;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Dark Spots", meta = (UIMin = 4, UIMax = 64, ClampMin = 2, ClampMax = 64, ToolTip = "Number of grid cells along the longest axis of the dark spot region."))
+	int32 DarkSpotResolution = 24;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Dark Spots", meta = (UIMin = 1000, UIMax = 50000, ClampMin = 100, EditCondition = "DarkSpotRegion == EBEDarkSpotRegion::ViewFrustum", ToolTip = "How far into the view the dark spot grid reaches."))
+	float DarkSpotViewDistance = 10000;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Dark Spots", meta = (UIMin = 0.01, UIMax = 100, ClampMin = 0, ToolTip = "Cells with an estimated direct illuminance below this value (lux) are highlighted as dark spots."))
+	float DarkSpotThreshold = 1.0f;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Dark Spots", meta = (ToolTip = "Trace from every cell to the lights that reach it so walls block light. Slower on large grids."))
+	bool bDarkSpotOcclusion = false;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Dark Spots", meta = (UIMin = 64, UIMax = 8192, ClampMin = 1, EditCondition = "bDarkSpotOcclusion", ToolTip = "Maximum number of occlusion traces the dark spot grid runs per frame. Large grids resolve their occlusion over several frames."))
+	int32 DarkSpotTracesPerFrame = 1024;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Light Cost", meta = (ToolTip = "Count the primitives and triangles touched by the Bright Eye and show them on the panel."))
+	bool bEstimateLightCost = true;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Light Cost", meta = (EditCondition = "bEstimateLightCost", ToolTip = "Shorten the light's reach automatically when it touches more primitives than the budget."))
+	bool bCapLightCost = false;
+
+	UPROPERTY(EditAnywhere, config, Category = "Bright Eye|Light Cost", meta = (UIMin = 10, UIMax = 20000, ClampMin = 1, EditCondition = "bEstimateLightCost && bCapLightCost", ToolTip = "Maximum number of primitives the Bright Eye may touch when the light cost cap is on."))
+	int32 LightCostPrimitiveBudget = 2000;
+
 	/* Resets the Bright Eye tool settings to their default values. */
 	UFUNCTION(CallInEditor,Category = "Bright Eye")
 	void ResetToolSettings();
@@ -69,6 +144,9 @@ public:
 	/* Opens the Bright Eye documentation in a web browser. */
 	UFUNCTION(CallInEditor,Category = "Bright Eye")
 	void OpenDocumentation() const;
+
+	// Returns the active rig preset, or null when there is none.
+	FBERigPreset* GetActiveRigPreset();
 	
 	void SaveToolConfig();
 	void LoadToolConfig();
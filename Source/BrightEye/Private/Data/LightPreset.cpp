@@ -0,0 +1,30 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "LightPreset.h"
+#include "Engine/TextureLightProfile.h"
+
+TArray<FBELightPreset> FBELightPreset::MakeDefaults()
+{
+	TArray<FBELightPreset> Presets;
+
+	FBELightPreset& Default = Presets.AddDefaulted_GetRef();
+	Default.Name = TEXT("Default");
+
+	FBELightPreset& InteriorFill = Presets.AddDefaulted_GetRef();
+	InteriorFill.Name = TEXT("Interior Fill");
+	InteriorFill.Brightness = 0.25f;
+	InteriorFill.Radius = 0.8f;
+	InteriorFill.Distance = 0.15f;
+	InteriorFill.Color = FLinearColor(1.0f, 0.9f, 0.78f);
+	InteriorFill.ColorTemperature = 4500.0f;
+
+	FBELightPreset& LongRangeSearch = Presets.AddDefaulted_GetRef();
+	LongRangeSearch.Name = TEXT("Long-Range Search");
+	LongRangeSearch.Brightness = 0.85f;
+	LongRangeSearch.Radius = 0.12f;
+	LongRangeSearch.Distance = 0.9f;
+	LongRangeSearch.ColorTemperature = 7500.0f;
+
+	return Presets;
+}
@@ -0,0 +1,39 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LightPreset.generated.h"
+
+class UTextureLightProfile;
+
+/** A named set of Bright Eye light parameters that can be switched to with one hotkey. */
+USTRUCT()
+struct FBELightPreset
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Light Presets", meta = (ToolTip = "Name of the preset."))
+	FString Name;
+
+	UPROPERTY(EditAnywhere, Category = "Light Presets", meta = (UIMin = 0.01, UIMax = 1, ClampMin = 0.01, ClampMax = 1, ToolTip = "Brightness of the preset."))
+	float Brightness = 0.4f;
+
+	UPROPERTY(EditAnywhere, Category = "Light Presets", meta = (UIMin = 0.01, UIMax = 1, ClampMin = 0.01, ClampMax = 1, ToolTip = "Radius of the preset."))
+	float Radius = 0.3f;
+
+	UPROPERTY(EditAnywhere, Category = "Light Presets", meta = (UIMin = 0.01, UIMax = 1, ClampMin = 0.01, ClampMax = 1, ToolTip = "Distance of the preset."))
+	float Distance = 0.4f;
+
+	UPROPERTY(EditAnywhere, Category = "Light Presets", meta = (ToolTip = "Light color of the preset."))
+	FLinearColor Color = FLinearColor::White;
+
+	UPROPERTY(EditAnywhere, Category = "Light Presets", meta = (UIMin = 1700.0f, UIMax = 12000.0f, ClampMin = 1700.0f, ClampMax = 12000.0f, ToolTip = "Color temperature of the preset in Kelvin. 6500 is neutral."))
+	float ColorTemperature = 6500.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Light Presets", meta = (ToolTip = "Light profile (IES texture) of the preset. Preset profiles are loaded ahead of time."))
+	TSoftObjectPtr<UTextureLightProfile> LightProfile = nullptr;
+
+	static TArray<FBELightPreset> MakeDefaults();
+};
@@ -0,0 +1,124 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "LightRig.h"
+#include "BrightEyeActor.h"
+#include "Components/SpotLightComponent.h"
+
+TArray<FBERigPreset> FBERigPreset::MakeDefaults()
+{
+	TArray<FBERigPreset> Presets;
+
+	FBERigPreset& Single = Presets.AddDefaulted_GetRef();
+	Single.Name = TEXT("Single");
+
+	FBERigPreset& ThreePoint = Presets.AddDefaulted_GetRef();
+	ThreePoint.Name = TEXT("Three Point");
+
+	FBERigLight& Fill = ThreePoint.Lights.AddDefaulted_GetRef();
+	Fill.Offset = FVector(0.0f, -150.0f, -40.0f);
+	Fill.Rotation = FRotator(0.0f, 12.0f, 0.0f);
+	Fill.OuterConeAngle = 55.0f;
+	Fill.IntensityScale = 0.35f;
+	Fill.Color = FLinearColor(0.85f, 0.92f, 1.0f);
+
+	FBERigLight& Rim = ThreePoint.Lights.AddDefaulted_GetRef();
+	Rim.Offset = FVector(900.0f, 200.0f, 300.0f);
+	Rim.Rotation = FRotator(-35.0f, 160.0f, 0.0f);
+	Rim.OuterConeAngle = 30.0f;
+	Rim.IntensityScale = 0.6f;
+	Rim.Color = FLinearColor(1.0f, 0.95f, 0.85f);
+
+	return Presets;
+}
+
+void FBELightRig::Build(ABEBrightEyeActor* InHost, USpotLightComponent* InMainLight)
+{
+	if(!IsValid(InHost) || !IsValid(InMainLight)){return;}
+
+	Host = InHost;
+	Root = NewObject<USceneComponent>(InHost, TEXT("BrightEyeRigRoot"));
+	InHost->SetRootComponent(Root);
+	InHost->RegisterHelperComponent(Root);
+
+	MainLight = InMainLight;
+	MainLight->AttachToComponent(Root, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+}
+
+void FBELightRig::Apply(const TArray<FBERigLight>& InLights)
+{
+	if(!IsValid(Host) || !IsValid(Root) || !IsValid(MainLight)){return;}
+
+	Params.Reset();
+	Params.Append(InLights.GetData(), FMath::Min(InLights.Num(), MaxLights));
+
+	LightParamIndices.Reset();
+	for (int32 Index = 0; Index < Params.Num(); ++Index)
+	{
+		if (Params[Index].bEnabled)
+		{
+			LightParamIndices.Add(Index);
+		}
+	}
+
+	// Components are pooled, so switching presets only creates or destroys the difference.
+	while (Lights.Num() > LightParamIndices.Num())
+	{
+		if (USpotLightComponent* Light = Lights.Pop())
+		{
+			Light->DestroyComponent();
+		}
+	}
+
+	while (Lights.Num() < LightParamIndices.Num())
+	{
+		USpotLightComponent* Light = NewObject<USpotLightComponent>(Host);
+		Light->SetupAttachment(MainLight);
+		Light->SetInnerConeAngle(0);
+		Light->SetCastShadows(false);
+		Host->RegisterHelperComponent(Light);
+		Lights.Add(Light);
+	}
+
+	const bool bIsVisible = MainLight->IsVisible();
+
+	for (int32 LightIndex = 0; LightIndex < Lights.Num(); ++LightIndex)
+	{
+		USpotLightComponent* Light = Lights[LightIndex];
+		if(!IsValid(Light)){continue;}
+
+		const FBERigLight& Param = Params[LightParamIndices[LightIndex]];
+
+		Light->SetRelativeLocationAndRotation(Param.Offset, Param.Rotation);
+		Light->SetOuterConeAngle(Param.OuterConeAngle);
+		Light->SetLightColor(Param.Color);
+		Light->SetVisibility(bIsVisible);
+	}
+
+	SyncWithMainLight();
+}
+
+void FBELightRig::SyncWithMainLight() const
+{
+	if(!IsValid(MainLight)){return;}
+
+	for (int32 LightIndex = 0; LightIndex < Lights.Num(); ++LightIndex)
+	{
+		USpotLightComponent* Light = Lights[LightIndex];
+		if(!IsValid(Light)){continue;}
+
+		Light->SetIntensity(MainLight->Intensity * Params[LightParamIndices[LightIndex]].IntensityScale);
+		Light->SetAttenuationRadius(MainLight->AttenuationRadius);
+	}
+}
+
+void FBELightRig::Reset()
+{
+	// The components belong to the host actor and go away with it.
+	Host = nullptr;
+	Root = nullptr;
+	MainLight = nullptr;
+	Params.Reset();
+	Lights.Reset();
+	LightParamIndices.Reset();
+}
@@ -0,0 +1,82 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LightRig.generated.h"
+
+class ABEBrightEyeActor;
+class USceneComponent;
+class USpotLightComponent;
+
+/** One extra light of the Bright Eye rig, placed relative to the main light. */
+USTRUCT()
+struct FBERigLight
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Light Rig", meta = (ToolTip = "Whether this light is part of the rig."))
+	bool bEnabled = true;
+
+	UPROPERTY(EditAnywhere, Category = "Light Rig", meta = (ToolTip = "Offset from the main light in its own space. X is along the beam, Y is right and Z is up."))
+	FVector Offset = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, Category = "Light Rig", meta = (ToolTip = "Rotation relative to the main light."))
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	UPROPERTY(EditAnywhere, Category = "Light Rig", meta = (UIMin = 1, UIMax = 80, ClampMin = 1, ClampMax = 80, ToolTip = "Outer cone angle of this light."))
+	float OuterConeAngle = 40.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Light Rig", meta = (UIMin = 0, UIMax = 2, ClampMin = 0, ToolTip = "Intensity relative to the main light."))
+	float IntensityScale = 0.5f;
+
+	UPROPERTY(EditAnywhere, Category = "Light Rig", meta = (ToolTip = "Color of this light."))
+	FLinearColor Color = FLinearColor::White;
+};
+
+/** A named set of rig lights that can be switched as a whole. */
+USTRUCT()
+struct FBERigPreset
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Light Rig", meta = (ToolTip = "Name shown on the panel."))
+	FString Name;
+
+	UPROPERTY(EditAnywhere, Category = "Light Rig", meta = (ToolTip = "Lights added around the main light. Only the first four are used."))
+	TArray<FBERigLight> Lights;
+
+	static TArray<FBERigPreset> MakeDefaults();
+};
+
+/**
+ * FBELightRig owns the root that the Bright Eye follows the camera with, the main light under it, and the extra rig lights
+ * under the main light. Following the camera moves the root only, and the lights inherit it through attachment.
+ * Rig parameters are kept in one contiguous array and applied to all lights in a single pass.
+ */
+class FBELightRig
+{
+public:
+	static constexpr int32 MaxLights = 4;
+
+	// Creates the rig root on the host and attaches the main light under it.
+	void Build(ABEBrightEyeActor* InHost, USpotLightComponent* InMainLight);
+	void Apply(const TArray<FBERigLight>& InLights);
+
+	// Copies the main light's intensity and reach to the rig lights, scaled per light.
+	void SyncWithMainLight() const;
+	void Reset();
+
+	USceneComponent* GetRoot() const { return Root; }
+	int32 Num() const { return Params.Num(); }
+
+private:
+	TObjectPtr<ABEBrightEyeActor> Host;
+	TObjectPtr<USceneComponent> Root;
+	TObjectPtr<USpotLightComponent> MainLight;
+
+	TArray<FBERigLight> Params;
+	TArray<TObjectPtr<USpotLightComponent>> Lights;
+	TArray<int32> LightParamIndices;
+};
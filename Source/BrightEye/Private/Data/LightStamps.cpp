@@ -0,0 +1,184 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "LightStamps.h"
+#include "BrightEyeActor.h"
+#include "ConvexVolume.h"
+#include "ScopedTransaction.h"
+#include "Components/SpotLightComponent.h"
+#include "Engine/SpotLight.h"
+#include "Engine/TextureLightProfile.h"
+
+#define LOCTEXT_NAMESPACE "FBELightStamps"
+
+int32 FBELightStamps::Add(ABEBrightEyeActor* InHost, const USpotLightComponent* InSource, const int32 InMaxStamps)
+{
+	if (!IsValid(InHost) || !IsValid(InSource) || Num() >= InMaxStamps) { return INDEX_NONE; }
+
+	USpotLightComponent* StampComponent = NewObject<USpotLightComponent>(InHost, NAME_None, RF_Transient);
+	if (!IsValid(StampComponent)) { return INDEX_NONE; }
+
+	const FTransform SourceTransform = InSource->GetComponentTransform();
+
+	StampComponent->SetWorldLocationAndRotation(SourceTransform.GetLocation(), SourceTransform.GetRotation());
+	StampComponent->SetInnerConeAngle(0);
+	StampComponent->SetOuterConeAngle(InSource->OuterConeAngle);
+	StampComponent->SetIntensity(InSource->Intensity);
+	StampComponent->SetAttenuationRadius(InSource->AttenuationRadius);
+	StampComponent->SetLightColor(InSource->GetLightColor());
+	StampComponent->SetIESTexture(InSource->IESTexture);
+	StampComponent->SetCastShadows(false);
+	StampComponent->SetVisibility(bEnabled);
+	InHost->RegisterHelperComponent(StampComponent);
+
+	Locations.Add(SourceTransform.GetLocation());
+	Rotations.Add(SourceTransform.GetRotation());
+	Intensities.Add(InSource->Intensity);
+	OuterConeAngles.Add(InSource->OuterConeAngle);
+	AttenuationRadii.Add(InSource->AttenuationRadius);
+	Colors.Add(InSource->GetLightColor());
+	Profiles.Add(InSource->IESTexture);
+	CulledFlags.Add(false);
+	VisibleFlags.Add(bEnabled);
+
+	return Components.Add(StampComponent);
+}
+
+void FBELightStamps::SetAllEnabled(const bool bInEnabled)
+{
+	if (bEnabled == bInEnabled) { return; }
+
+	bEnabled = bInEnabled;
+
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		ApplyVisibility(Index);
+	}
+}
+
+void FBELightStamps::SetAllColor(const FLinearColor& InColor)
+{
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		Colors[Index] = InColor;
+
+		if (IsValid(Components[Index]))
+		{
+			Components[Index]->SetLightColor(InColor);
+		}
+	}
+}
+
+void FBELightStamps::ScaleAllIntensity(const float InScale)
+{
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		Intensities[Index] *= InScale;
+
+		if (IsValid(Components[Index]))
+		{
+			Components[Index]->SetIntensity(Intensities[Index]);
+		}
+	}
+}
+
+void FBELightStamps::Cull(const FConvexVolume* InViewFrustum, const FVector& InViewLocation, const float InMaxDistance)
+{
+	const int32 StampCount = Locations.Num();
+	const FVector::FReal MaxDistanceSquared = FMath::Square(static_cast<FVector::FReal>(InMaxDistance));
+
+	for (int32 Index = 0; Index < StampCount; ++Index)
+	{
+		const FVector& Location = Locations[Index];
+		const float Radius = AttenuationRadii[Index];
+
+		// The attenuation sphere is the only part of a stamp that can light anything, so it is what gets tested.
+		const FVector::FReal ReachDistance = FMath::Max<FVector::FReal>(FVector::Dist(Location, InViewLocation) - Radius, 0);
+		bool bCulled = FMath::Square(ReachDistance) > MaxDistanceSquared;
+
+		if (!bCulled && InViewFrustum)
+		{
+			bCulled = !InViewFrustum->IntersectSphere(Location, Radius);
+		}
+
+		if (CulledFlags[Index] != bCulled)
+		{
+			CulledFlags[Index] = bCulled;
+			ApplyVisibility(Index);
+		}
+	}
+}
+
+int32 FBELightStamps::ConvertToLevelActors(UWorld* InWorld)
+{
+	if (!IsValid(InWorld) || Num() == 0) { return 0; }
+
+	const FScopedTransaction Transaction(LOCTEXT("ConvertLightStamps", "Convert Bright Eye Stamps To Lights"));
+
+	int32 ConvertedCount = 0;
+
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		ASpotLight* SpotLight = InWorld->SpawnActor<ASpotLight>(Locations[Index], Rotations[Index].Rotator());
+		if (!IsValid(SpotLight) || !IsValid(SpotLight->SpotLightComponent)) { continue; }
+
+		USpotLightComponent* LightComponent = SpotLight->SpotLightComponent;
+		LightComponent->SetInnerConeAngle(0);
+		LightComponent->SetOuterConeAngle(OuterConeAngles[Index]);
+		LightComponent->SetIntensity(Intensities[Index]);
+		LightComponent->SetAttenuationRadius(AttenuationRadii[Index]);
+		LightComponent->SetLightColor(Colors[Index]);
+		LightComponent->SetIESTexture(Profiles[Index]);
+
+		SpotLight->SetActorLabel(FString::Printf(TEXT("BrightEyeStamp_%d"), Index));
+
+		++ConvertedCount;
+	}
+
+	Clear();
+
+	return ConvertedCount;
+}
+
+void FBELightStamps::Clear()
+{
+	for (USpotLightComponent* Component : Components)
+	{
+		if (IsValid(Component))
+		{
+			Component->DestroyComponent();
+		}
+	}
+
+	Locations.Reset();
+	Rotations.Reset();
+	Intensities.Reset();
+	OuterConeAngles.Reset();
+	AttenuationRadii.Reset();
+	Colors.Reset();
+	Profiles.Reset();
+	Components.Reset();
+	CulledFlags.Reset();
+	VisibleFlags.Reset();
+}
+
+int32 FBELightStamps::NumVisible() const
+{
+	return VisibleFlags.CountSetBits();
+}
+
+void FBELightStamps::ApplyVisibility(const int32 InIndex)
+{
+	const bool bVisible = bEnabled && !CulledFlags[InIndex];
+
+	if (VisibleFlags[InIndex] == bVisible) { return; }
+
+	VisibleFlags[InIndex] = bVisible;
+
+	if (IsValid(Components[InIndex]))
+	{
+		Components[InIndex]->SetVisibility(bVisible);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
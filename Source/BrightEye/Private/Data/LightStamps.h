@@ -0,0 +1,52 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ABEBrightEyeActor;
+class USpotLightComponent;
+class UTextureLightProfile;
+struct FConvexVolume;
+
+/**
+ * Holds the transient work lights stamped from the Bright Eye as a structure of arrays.
+ * Every batched operation walks only the arrays it needs, and a stamp's component is touched only when its effective state changes.
+ */
+struct FBELightStamps
+{
+	// Freezes a copy of the source light under the host actor. Returns the new stamp index or INDEX_NONE.
+	int32 Add(ABEBrightEyeActor* InHost, const USpotLightComponent* InSource, int32 InMaxStamps);
+
+	// Batched operations
+	void SetAllEnabled(bool bInEnabled);
+	void SetAllColor(const FLinearColor& InColor);
+	void ScaleAllIntensity(float InScale);
+	void Cull(const FConvexVolume* InViewFrustum, const FVector& InViewLocation, float InMaxDistance);
+
+	// Spawns a real spot light actor for every stamp in one transaction, then clears the stamps.
+	int32 ConvertToLevelActors(UWorld* InWorld);
+	void Clear();
+
+	int32 Num() const { return Components.Num(); }
+	int32 NumVisible() const;
+	bool AreEnabled() const { return bEnabled; }
+
+private:
+	void ApplyVisibility(int32 InIndex);
+
+	TArray<FVector> Locations;
+	TArray<FQuat> Rotations;
+	TArray<float> Intensities;
+	TArray<float> OuterConeAngles;
+	TArray<float> AttenuationRadii;
+	TArray<FLinearColor> Colors;
+	TArray<TObjectPtr<UTextureLightProfile>> Profiles;
+	TArray<TObjectPtr<USpotLightComponent>> Components;
+
+	TBitArray<> CulledFlags;
+	TBitArray<> VisibleFlags;
+
+	bool bEnabled = true;
+};
@@ -6,10 +6,12 @@
 #include "CoreMinimal.h"
 #include "Widgets/SWidget.h"
 #include "Framework/Application/SlateApplication.h"
+#include "System/BrightEyeStats.h"
 
 /**
  * Structure to manage fade-out and fade-in animation for a panel (SWidget).
  * Uses FTSTicker for real-time updates and allows setting the widget, fade-out amount, duration, and start delay dynamically.
+ * At most one ticker is registered at a time, and the widget is held weakly since the widget owns this manager.
  */
 struct FPanelFadeOutManager
 {
@@ -24,11 +26,7 @@ struct FPanelFadeOutManager
 
     ~FPanelFadeOutManager()
     {
-        if (TickerHandle.IsValid())
-        {
-            FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
-            TickerHandle.Reset();
-        }
+        StopTicker();
     }
 
     // Starts the fade-out animation with separate fade-out and fade-in durations
@@ -49,12 +47,12 @@ struct FPanelFadeOutManager
         if (StartDelay > 0.0f)
         {
             DelayStartTime = FSlateApplication::Get().GetCurrentTime();
-            TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FPanelFadeOutManager::HandleStartDelay), 0.01f);
+            StartTicker(&FPanelFadeOutManager::HandleStartDelay);
         }
         else
         {
             FadeStartTime = FSlateApplication::Get().GetCurrentTime();
-            TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FPanelFadeOutManager::UpdateFadeOut), 0.01f);
+            StartTicker(&FPanelFadeOutManager::UpdateFadeOut);
         }
     }
 
@@ -71,7 +69,7 @@ struct FPanelFadeOutManager
         TotalElapsedTime = 0.0f;
 
         FadeStartTime = FSlateApplication::Get().GetCurrentTime();
-        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FPanelFadeOutManager::UpdateFadeIn), 0.01f);
+        StartTicker(&FPanelFadeOutManager::UpdateFadeIn);
     }
 
     // Stops the current animation and starts fade-in
@@ -81,7 +79,7 @@ struct FPanelFadeOutManager
         {
             // Stop the current animation and reset animating state
             bIsAnimating = false;
-            FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+            StopTicker();
 
             // Directly start fade-in
             StartFadeIn(InWidget, InFadeInDuration);
@@ -102,9 +100,7 @@ private:
         if (ElapsedDelayTime >= StartDelay)
         {
             FadeStartTime = FSlateApplication::Get().GetCurrentTime();
-            FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
-
-            TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FPanelFadeOutManager::UpdateFadeOut), 0.01f);
+            StartTicker(&FPanelFadeOutManager::UpdateFadeOut);
             return false;
         }
         return true;
@@ -122,7 +118,7 @@ private:
         {
             bIsAnimating = false;
             bFadeOutComplete = true;
-            FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+            StopTicker();
             return false;
         }
 
@@ -140,23 +136,44 @@ private:
         if (TotalElapsedTime >= FadeInDuration)
         {
             bIsAnimating = false;
-            FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+            StopTicker();
             return false;
         }
 
         return true;
     }
 
+    // Replaces the running ticker, so repeated hovers never stack tickers on top of each other
+    void StartTicker(bool (FPanelFadeOutManager::*InUpdate)(float))
+    {
+        StopTicker();
+
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, InUpdate), 0.01f);
+        INC_DWORD_STAT(STAT_BrightEyeFadeTickers);
+        ++FBrightEyeLiveCounts::FadeTickers;
+    }
+
+    void StopTicker()
+    {
+        if (TickerHandle.IsValid())
+        {
+            FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+            TickerHandle.Reset();
+            DEC_DWORD_STAT(STAT_BrightEyeFadeTickers);
+            --FBrightEyeLiveCounts::FadeTickers;
+        }
+    }
+
     // Function to apply the calculated opacity to the widget
     void SetWidgetOpacity(float InOpacity) const
     {
-        if (Widget.IsValid())
+        if (const TSharedPtr<SWidget> PinnedWidget = Widget.Pin())
         {
-            Widget->SetRenderOpacity(InOpacity);
+            PinnedWidget->SetRenderOpacity(InOpacity);
         }
     }
 
-    TSharedPtr<SWidget> Widget;
+    TWeakPtr<SWidget> Widget;
     float FadeOutAmount;
     float FadeInDuration;
     float FadeOutDuration;
@@ -0,0 +1,879 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "DarkSpotFinder.h"
+#include "ConvexVolume.h"
+#include "EngineUtils.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Components/DirectionalLightComponent.h"
+#include "Components/LineBatchComponent.h"
+#include "Components/LocalLightComponent.h"
+#include "Components/SpotLightComponent.h"
+#include "Engine/World.h"
+
+// Light intensities are in candela and distances in centimeters, so this brings the estimate to lux.
+constexpr float CandelaToLuxScale = 10000.0f;
+constexpr float MinDistanceSq = 100.0f;
+constexpr float OcclusionEpsilon = 0.01f;
+constexpr float DirectionalTraceDistance = 200000.0f;
+constexpr float DarkSpotPointSize = 8.0f;
+constexpr int32 MaxCellsPerAxis = 64;
+
+namespace BEDarkSpotFinder
+{
+	/** Returns the direct illuminance of four lights at a time and optionally writes each light's share. */
+	float AccumulateLights(const float* PosX, const float* PosY, const float* PosZ,
+		const float* DirX, const float* DirY, const float* DirZ,
+		const float* Intensity, const float* InvRadiusSq, const float* CosOuter, const float* InvConeRange,
+		const int32 InNum, const FVector3f& InPosition, float* OutPerLight)
+	{
+		const VectorRegister4Float Px = VectorSetFloat1(InPosition.X);
+		const VectorRegister4Float Py = VectorSetFloat1(InPosition.Y);
+		const VectorRegister4Float Pz = VectorSetFloat1(InPosition.Z);
+		const VectorRegister4Float Zero = VectorZeroFloat();
+		const VectorRegister4Float One = VectorOneFloat();
+		const VectorRegister4Float MinDistance = VectorSetFloat1(MinDistanceSq);
+
+		VectorRegister4Float Sum = Zero;
+
+		for (int32 Index = 0; Index < InNum; Index += 4)
+		{
+			const VectorRegister4Float Dx = VectorSubtract(Px, VectorLoad(PosX + Index));
+			const VectorRegister4Float Dy = VectorSubtract(Py, VectorLoad(PosY + Index));
+			const VectorRegister4Float Dz = VectorSubtract(Pz, VectorLoad(PosZ + Index));
+
+			const VectorRegister4Float DistanceSq = VectorMax(VectorMultiplyAdd(Dz, Dz, VectorMultiplyAdd(Dy, Dy, VectorMultiply(Dx, Dx))), MinDistance);
+			const VectorRegister4Float InvDistance = VectorReciprocalSqrt(DistanceSq);
+
+			// Windowed inverse square falloff, the same shape the renderer uses for local lights.
+			const VectorRegister4Float Ratio = VectorMultiply(DistanceSq, VectorLoad(InvRadiusSq + Index));
+			VectorRegister4Float Window = VectorMax(VectorSubtract(One, VectorMultiply(Ratio, Ratio)), Zero);
+			Window = VectorMultiply(Window, Window);
+
+			const VectorRegister4Float CosAngle = VectorMultiply(VectorMultiplyAdd(Dz, VectorLoad(DirZ + Index),
+				VectorMultiplyAdd(Dy, VectorLoad(DirY + Index), VectorMultiply(Dx, VectorLoad(DirX + Index)))), InvDistance);
+			VectorRegister4Float Cone = VectorMultiply(VectorSubtract(CosAngle, VectorLoad(CosOuter + Index)), VectorLoad(InvConeRange + Index));
+			Cone = VectorMin(VectorMax(Cone, Zero), One);
+			Cone = VectorMultiply(Cone, Cone);
+
+			const VectorRegister4Float Contribution = VectorMultiply(VectorMultiply(VectorLoad(Intensity + Index), VectorMultiply(InvDistance, InvDistance)), VectorMultiply(Window, Cone));
+
+			Sum = VectorAdd(Sum, Contribution);
+
+			if (OutPerLight)
+			{
+				VectorStore(Contribution, OutPerLight + Index);
+			}
+		}
+
+		alignas(16) float Lanes[4];
+		VectorStoreAligned(Sum, Lanes);
+		return Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3];
+	}
+}
+
+void FBEDarkSpotFinder::FLightArrays::Reset()
+{
+	PosX.Reset(); PosY.Reset(); PosZ.Reset();
+	DirX.Reset(); DirY.Reset(); DirZ.Reset();
+	Intensity.Reset();
+	RadiusSq.Reset();
+	InvRadiusSq.Reset();
+	CosOuter.Reset();
+	InvConeRange.Reset();
+	SourceIndex.Reset();
+}
+
+void FBEDarkSpotFinder::FLightArrays::AddDefaulted()
+{
+	// A zero intensity point light, which is also what padding lanes look like.
+	PosX.Add(0); PosY.Add(0); PosZ.Add(0);
+	DirX.Add(1); DirY.Add(0); DirZ.Add(0);
+	Intensity.Add(0);
+	RadiusSq.Add(0);
+	InvRadiusSq.Add(0);
+	CosOuter.Add(-2.0f);
+	InvConeRange.Add(1.0f);
+	SourceIndex.Add(INDEX_NONE);
+}
+
+void FBEDarkSpotFinder::FLightArrays::CopyFrom(const FLightArrays& InOther, const int32 InIndex)
+{
+	PosX.Add(InOther.PosX[InIndex]); PosY.Add(InOther.PosY[InIndex]); PosZ.Add(InOther.PosZ[InIndex]);
+	DirX.Add(InOther.DirX[InIndex]); DirY.Add(InOther.DirY[InIndex]); DirZ.Add(InOther.DirZ[InIndex]);
+	Intensity.Add(InOther.Intensity[InIndex]);
+	RadiusSq.Add(InOther.RadiusSq[InIndex]);
+	InvRadiusSq.Add(InOther.InvRadiusSq[InIndex]);
+	CosOuter.Add(InOther.CosOuter[InIndex]);
+	InvConeRange.Add(InOther.InvConeRange[InIndex]);
+	SourceIndex.Add(InIndex);
+}
+
+void FBEDarkSpotFinder::FLightArrays::PadToVectorWidth()
+{
+	while (Num() % 4 != 0)
+	{
+		AddDefaulted();
+	}
+}
+
+void FBEDarkSpotFinder::FDirectionalArrays::Reset()
+{
+	Directions.Reset();
+	Illuminance.Reset();
+}
+
+void FBEDarkSpotFinder::FDirectionalArrays::Add(const FVector& InDirection, const float InIlluminance)
+{
+	Directions.Add(InDirection);
+	Illuminance.Add(InIlluminance);
+}
+
+void FBEDarkSpotFinder::FLightChanges::Reset()
+{
+	Lights.Reset();
+	Directionals.Reset();
+}
+
+FVector3f FBEDarkSpotFinder::FGridLayout::GetLocalCellCenter(const int32 InX, const int32 InY, const int32 InZ) const
+{
+	return FVector3f((InX + 0.5f) * CellSize.X, (InY + 0.5f) * CellSize.Y, (InZ + 0.5f) * CellSize.Z);
+}
+
+FVector3f FBEDarkSpotFinder::FGridLayout::GetLocalCellCenter(const int32 InCellIndex) const
+{
+	const int32 X = InCellIndex % CellCount.X;
+	const int32 Y = (InCellIndex / CellCount.X) % CellCount.Y;
+	const int32 Z = InCellIndex / (CellCount.X * CellCount.Y);
+
+	return GetLocalCellCenter(X, Y, Z);
+}
+
+void FBEDarkSpotFinder::Build(UWorld* InWorld, const FBox& InBounds, const int32 InResolution, const bool bInTraceOcclusion, const AActor* InIgnoredActor)
+{
+	Reset();
+
+	if (!IsValid(InWorld) || !InBounds.IsValid) { return; }
+
+	World = InWorld;
+	IgnoredActor = InIgnoredActor;
+
+	const int32 Resolution = FMath::Clamp(InResolution, 2, MaxCellsPerAxis);
+
+	// Cubic-ish cells sized from the longest axis.
+	const FVector Extent = InBounds.GetSize();
+	const double CellEdge = FMath::Max(Extent.GetMax() / Resolution, 1.0);
+
+	Grid.CellCount.X = FMath::Clamp(FMath::CeilToInt(Extent.X / CellEdge), 1, MaxCellsPerAxis);
+	Grid.CellCount.Y = FMath::Clamp(FMath::CeilToInt(Extent.Y / CellEdge), 1, MaxCellsPerAxis);
+	Grid.CellCount.Z = FMath::Clamp(FMath::CeilToInt(Extent.Z / CellEdge), 1, MaxCellsPerAxis);
+
+	Grid.Origin = InBounds.Min;
+	Grid.CellSize = FVector3f(Extent.X / Grid.CellCount.X, Extent.Y / Grid.CellCount.Y, Extent.Z / Grid.CellCount.Z);
+	Grid.bTraceOcclusion = bInTraceOcclusion;
+
+	FUpdateRequest Request;
+	Request.Grid = Grid;
+	Request.bIsFullBuild = true;
+	GatherLights(Request.Added);
+
+	StartUpdate(MoveTemp(Request));
+}
+
+void FBEDarkSpotFinder::Reset()
+{
+	// A running update only holds its own request, so it can finish on its own.
+	PendingUpdate = TFuture<FUpdateResultPtr>();
+	OcclusionTests.Reset();
+	NextOcclusionTest = 0;
+
+	Illuminance.Reset();
+	SolidCells.Reset();
+	Lights.Reset();
+	LightSources.Reset();
+	LightIndices.Reset();
+	Directionals.Reset();
+	DirectionalSources.Reset();
+	DirectionalIndices.Reset();
+	DirtyLights.Reset();
+	StagedRemovals.Reset();
+	Grid = FGridLayout();
+}
+
+void FBEDarkSpotFinder::MarkLightDirty(const ULightComponent* InLight)
+{
+	if (IsBuilt() && InLight && InLight->GetOwner() != IgnoredActor.Get())
+	{
+		DirtyLights.Add(InLight);
+	}
+}
+
+void FBEDarkSpotFinder::MarkActorDirty(const AActor* InActor)
+{
+	if (!IsBuilt() || !InActor || InActor == IgnoredActor.Get()) { return; }
+
+	TInlineComponentArray<ULightComponent*> LightComponents(InActor);
+	for (const ULightComponent* LightComponent : LightComponents)
+	{
+		DirtyLights.Add(LightComponent);
+	}
+}
+
+void FBEDarkSpotFinder::RemoveActorLights(const AActor* InActor)
+{
+	if (!IsBuilt() || !InActor) { return; }
+
+	// The actor is going away, so the contribution it had is staged for removal instead of being gathered again.
+	TInlineComponentArray<ULightComponent*> LightComponents(InActor);
+	for (const ULightComponent* LightComponent : LightComponents)
+	{
+		if (const int32* ExistingIndex = LightIndices.Find(LightComponent))
+		{
+			const int32 LightIndex = *ExistingIndex;
+
+			StagedRemovals.Lights.CopyFrom(Lights, LightIndex);
+			ClearLight(LightIndex);
+		}
+		else if (const int32* ExistingDirectionalIndex = DirectionalIndices.Find(LightComponent))
+		{
+			const int32 DirectionalIndex = *ExistingDirectionalIndex;
+
+			StagedRemovals.Directionals.Add(Directionals.Directions[DirectionalIndex], Directionals.Illuminance[DirectionalIndex]);
+			ClearDirectionalLight(DirectionalIndex);
+		}
+
+		DirtyLights.Remove(LightComponent);
+	}
+}
+
+bool FBEDarkSpotFinder::Tick(const int32 InOcclusionTraceBudget)
+{
+	if (!IsBuilt()) { return false; }
+
+	bool bHasChanged = ApplyFinishedUpdate();
+
+	// Changes wait for the full build to land, so the contribution they remove is always on the grid already.
+	if (!PendingUpdate.IsValid() && Illuminance.Num() > 0 && HasDirtyLights())
+	{
+		FUpdateRequest Request;
+		Request.Grid = Grid;
+		CollectDirtyLights(Request);
+
+		StartUpdate(MoveTemp(Request));
+	}
+
+	bHasChanged |= ResolveOcclusionTests(InOcclusionTraceBudget);
+
+	// Cells are not reported until their occlusion is resolved, so the grid never shows light leaking through walls.
+	return bHasChanged && !HasPendingOcclusion();
+}
+
+bool FBEDarkSpotFinder::FindDarkestCell(const FConvexVolume* InViewFrustum, FVector& OutLocation) const
+{
+	if (Illuminance.Num() == 0) { return false; }
+
+	float DarkestValue = TNumericLimits<float>::Max();
+	bool bFound = false;
+
+	for (int32 Z = 0; Z < Grid.CellCount.Z; ++Z)
+	{
+		for (int32 Y = 0; Y < Grid.CellCount.Y; ++Y)
+		{
+			for (int32 X = 0; X < Grid.CellCount.X; ++X)
+			{
+				const int32 CellIndex = Grid.GetCellIndex(X, Y, Z);
+				const float CellIlluminance = FMath::Max(Illuminance[CellIndex], 0.0f);
+				if (SolidCells[CellIndex] || CellIlluminance >= DarkestValue) { continue; }
+
+				const FVector CellCenter = Grid.Origin + FVector(Grid.GetLocalCellCenter(X, Y, Z));
+				if (InViewFrustum && !InViewFrustum->IntersectPoint(CellCenter)) { continue; }
+
+				DarkestValue = CellIlluminance;
+				OutLocation = CellCenter;
+				bFound = true;
+			}
+		}
+	}
+
+	return bFound;
+}
+
+void FBEDarkSpotFinder::DrawUnderLitCells(ULineBatchComponent* InLineBatcher, const float InThreshold) const
+{
+	if (!IsValid(InLineBatcher)) { return; }
+
+	InLineBatcher->Flush();
+
+	if (Illuminance.Num() == 0) { return; }
+
+	const float SafeThreshold = FMath::Max(InThreshold, KINDA_SMALL_NUMBER);
+
+	for (int32 Z = 0; Z < Grid.CellCount.Z; ++Z)
+	{
+		for (int32 Y = 0; Y < Grid.CellCount.Y; ++Y)
+		{
+			for (int32 X = 0; X < Grid.CellCount.X; ++X)
+			{
+				const int32 CellIndex = Grid.GetCellIndex(X, Y, Z);
+				const float CellIlluminance = FMath::Max(Illuminance[CellIndex], 0.0f);
+				if (SolidCells[CellIndex] || CellIlluminance >= InThreshold) { continue; }
+
+				const float Darkness = CellIlluminance / SafeThreshold;
+				const FLinearColor CellColor = FLinearColor::LerpUsingHSV(FLinearColor::Red, FLinearColor::Yellow, Darkness);
+
+				InLineBatcher->DrawPoint(Grid.Origin + FVector(Grid.GetLocalCellCenter(X, Y, Z)), CellColor, DarkSpotPointSize, SDPG_World);
+			}
+		}
+	}
+}
+
+void FBEDarkSpotFinder::GatherLights(FLightChanges& OutAdded)
+{
+	UWorld* GatherWorld = World.Get();
+	if (!IsValid(GatherWorld)) { return; }
+
+	for (TActorIterator<AActor> It(GatherWorld); It; ++It)
+	{
+		It->ForEachComponent<ULightComponent>(false, [this, &OutAdded](const ULightComponent* LightComponent)
+		{
+			AddLight(LightComponent, OutAdded);
+		});
+	}
+}
+
+void FBEDarkSpotFinder::AddLight(const ULightComponent* InLight, FLightChanges& OutAdded)
+{
+	if (!ShouldGatherLight(InLight)) { return; }
+
+	if (InLight->IsA<UDirectionalLightComponent>())
+	{
+		const int32 NewIndex = DirectionalSources.Add(InLight);
+		Directionals.Add(FVector::ForwardVector, 0.0f);
+		GatherDirectionalLight(InLight, NewIndex);
+		DirectionalIndices.Add(InLight, NewIndex);
+
+		OutAdded.Directionals.Add(Directionals.Directions[NewIndex], Directionals.Illuminance[NewIndex]);
+	}
+	else if (InLight->IsA<ULocalLightComponent>())
+	{
+		const int32 NewIndex = LightSources.Add(InLight);
+		Lights.AddDefaulted();
+		GatherLight(InLight, NewIndex);
+		LightIndices.Add(InLight, NewIndex);
+
+		OutAdded.Lights.CopyFrom(Lights, NewIndex);
+	}
+}
+
+bool FBEDarkSpotFinder::GatherLight(const ULightComponent* InLight, const int32 InIndex)
+{
+	const ULocalLightComponent* LocalLight = Cast<ULocalLightComponent>(InLight);
+	if (!ShouldGatherLight(LocalLight)) { return false; }
+
+	float CosOuterAngle = -2.0f;
+	float InvCosConeRange = 1.0f;
+
+	if (const USpotLightComponent* SpotLight = Cast<USpotLightComponent>(LocalLight))
+	{
+		const float InnerAngle = FMath::DegreesToRadians(FMath::Clamp(SpotLight->InnerConeAngle, 0.0f, 89.0f));
+		const float OuterAngle = FMath::Clamp(FMath::DegreesToRadians(SpotLight->OuterConeAngle), InnerAngle + 0.001f, FMath::DegreesToRadians(89.0f) + 0.001f);
+
+		CosOuterAngle = FMath::Cos(OuterAngle);
+		InvCosConeRange = 1.0f / (FMath::Cos(InnerAngle) - CosOuterAngle);
+	}
+
+	const float Candela = LocalLight->Intensity * ULocalLightComponent::GetUnitsConversionFactor(LocalLight->IntensityUnits, ELightUnits::Candelas, CosOuterAngle > -1.0f ? CosOuterAngle : -1.0f);
+	const float Radius = FMath::Max(LocalLight->AttenuationRadius, 1.0f);
+
+	const FVector3f LocalPosition = FVector3f(LocalLight->GetComponentLocation() - Grid.Origin);
+	const FVector3f Direction = FVector3f(LocalLight->GetDirection());
+
+	Lights.PosX[InIndex] = LocalPosition.X;
+	Lights.PosY[InIndex] = LocalPosition.Y;
+	Lights.PosZ[InIndex] = LocalPosition.Z;
+	Lights.DirX[InIndex] = Direction.X;
+	Lights.DirY[InIndex] = Direction.Y;
+	Lights.DirZ[InIndex] = Direction.Z;
+	Lights.Intensity[InIndex] = Candela * LocalLight->GetLightColor().GetLuminance() * CandelaToLuxScale;
+	Lights.RadiusSq[InIndex] = Radius * Radius;
+	Lights.InvRadiusSq[InIndex] = 1.0f / (Radius * Radius);
+	Lights.CosOuter[InIndex] = CosOuterAngle;
+	Lights.InvConeRange[InIndex] = InvCosConeRange;
+	Lights.SourceIndex[InIndex] = InIndex;
+
+	return true;
+}
+
+bool FBEDarkSpotFinder::GatherDirectionalLight(const ULightComponent* InLight, const int32 InIndex)
+{
+	const UDirectionalLightComponent* DirectionalLight = Cast<UDirectionalLightComponent>(InLight);
+	if (!ShouldGatherLight(DirectionalLight)) { return false; }
+
+	Directionals.Directions[InIndex] = DirectionalLight->GetDirection();
+	Directionals.Illuminance[InIndex] = DirectionalLight->Intensity * DirectionalLight->GetLightColor().GetLuminance();
+
+	return true;
+}
+
+void FBEDarkSpotFinder::ClearLight(const int32 InIndex)
+{
+	Lights.Intensity[InIndex] = 0.0f;
+	Lights.RadiusSq[InIndex] = 0.0f;
+	LightIndices.Remove(LightSources[InIndex]);
+}
+
+void FBEDarkSpotFinder::ClearDirectionalLight(const int32 InIndex)
+{
+	Directionals.Illuminance[InIndex] = 0.0f;
+	DirectionalIndices.Remove(DirectionalSources[InIndex]);
+}
+
+void FBEDarkSpotFinder::CollectDirtyLights(FUpdateRequest& OutRequest)
+{
+	OutRequest.Removed = MoveTemp(StagedRemovals);
+	StagedRemovals.Reset();
+
+	// Every dirty light takes its old contribution off the grid and puts its regathered one back.
+	for (const TWeakObjectPtr<const ULightComponent>& DirtyLight : DirtyLights)
+	{
+		if (const int32* ExistingIndex = LightIndices.Find(DirtyLight))
+		{
+			const int32 LightIndex = *ExistingIndex;
+
+			OutRequest.Removed.Lights.CopyFrom(Lights, LightIndex);
+
+			if (GatherLight(DirtyLight.Get(), LightIndex))
+			{
+				OutRequest.Added.Lights.CopyFrom(Lights, LightIndex);
+			}
+			else
+			{
+				ClearLight(LightIndex);
+			}
+		}
+		else if (const int32* ExistingDirectionalIndex = DirectionalIndices.Find(DirtyLight))
+		{
+			const int32 DirectionalIndex = *ExistingDirectionalIndex;
+
+			OutRequest.Removed.Directionals.Add(Directionals.Directions[DirectionalIndex], Directionals.Illuminance[DirectionalIndex]);
+
+			if (GatherDirectionalLight(DirtyLight.Get(), DirectionalIndex))
+			{
+				OutRequest.Added.Directionals.Add(Directionals.Directions[DirectionalIndex], Directionals.Illuminance[DirectionalIndex]);
+			}
+			else
+			{
+				ClearDirectionalLight(DirectionalIndex);
+			}
+		}
+		else
+		{
+			AddLight(DirtyLight.Get(), OutRequest.Added);
+		}
+	}
+
+	DirtyLights.Reset();
+}
+
+void FBEDarkSpotFinder::StartUpdate(FUpdateRequest&& InRequest)
+{
+	PendingUpdate = Async(EAsyncExecution::ThreadPool, [Request = MoveTemp(InRequest)]()
+	{
+		return RunUpdate(Request);
+	});
+}
+
+bool FBEDarkSpotFinder::ApplyFinishedUpdate()
+{
+	if (!PendingUpdate.IsValid() || !PendingUpdate.IsReady()) { return false; }
+
+	const FUpdateResultPtr Result = PendingUpdate.Get();
+	PendingUpdate = TFuture<FUpdateResultPtr>();
+
+	if (!Result.IsValid()) { return false; }
+
+	if (Result->bIsFullBuild)
+	{
+		Illuminance = MoveTemp(Result->Illuminance);
+		SolidCells.Init(false, Grid.Num());
+		OcclusionTests.Reset();
+		NextOcclusionTest = 0;
+	}
+	else
+	{
+		for (int32 Index = 0; Index < Result->DeltaCells.Num(); ++Index)
+		{
+			Illuminance[Result->DeltaCells[Index]] += Result->Deltas[Index];
+		}
+	}
+
+	OcclusionTests.Append(MoveTemp(Result->OcclusionTests));
+	return true;
+}
+
+bool FBEDarkSpotFinder::ResolveOcclusionTests(const int32 InTraceBudget)
+{
+	if (!HasPendingOcclusion()) { return false; }
+
+	const int32 BatchStart = NextOcclusionTest;
+	const int32 BatchCount = FMath::Min(FMath::Max(InTraceBudget, 1), OcclusionTests.Num() - BatchStart);
+	NextOcclusionTest += BatchCount;
+
+	TArray<bool> Blocked;
+	Blocked.SetNumZeroed(BatchCount);
+
+	ParallelFor(BatchCount, [this, BatchStart, &Blocked](const int32 Index)
+	{
+		const FOcclusionTest& Test = OcclusionTests[BatchStart + Index];
+		const FVector CellCenter = Grid.Origin + FVector(Grid.GetLocalCellCenter(Test.CellIndex));
+
+		if (Test.bIsSolidProbe)
+		{
+			Blocked[Index] = IsSolid(CellCenter);
+		}
+		else if (!SolidCells[Test.CellIndex])
+		{
+			// Solid cells are never shown, so the traces from them are skipped.
+			Blocked[Index] = IsOccluded(CellCenter, Test.To);
+		}
+	});
+
+	for (int32 Index = 0; Index < BatchCount; ++Index)
+	{
+		if (!Blocked[Index]) { continue; }
+
+		const FOcclusionTest& Test = OcclusionTests[BatchStart + Index];
+		if (Test.bIsSolidProbe)
+		{
+			SolidCells[Test.CellIndex] = true;
+		}
+		else
+		{
+			Illuminance[Test.CellIndex] += Test.Correction;
+		}
+	}
+
+	if (!HasPendingOcclusion())
+	{
+		OcclusionTests.Reset();
+		NextOcclusionTest = 0;
+	}
+
+	return true;
+}
+
+FBEDarkSpotFinder::FUpdateResultPtr FBEDarkSpotFinder::RunUpdate(const FUpdateRequest& InRequest)
+{
+	FUpdateResultPtr Result = MakeShared<FUpdateResult, ESPMode::ThreadSafe>();
+	Result->bIsFullBuild = InRequest.bIsFullBuild;
+
+	if (InRequest.bIsFullBuild)
+	{
+		EvaluateAllCells(InRequest, *Result);
+	}
+	else
+	{
+		EvaluateChanges(InRequest, *Result);
+	}
+
+	return Result;
+}
+
+void FBEDarkSpotFinder::EvaluateAllCells(const FUpdateRequest& InRequest, FUpdateResult& OutResult)
+{
+	const FGridLayout& Layout = InRequest.Grid;
+	const FLightArrays& AddedLights = InRequest.Added.Lights;
+	const FDirectionalArrays& AddedDirectionals = InRequest.Added.Directionals;
+
+	OutResult.Illuminance.SetNumZeroed(Layout.Num());
+
+	const int32 RowCount = Layout.CellCount.Y * Layout.CellCount.Z;
+
+	TArray<FWorkerContext> Contexts;
+	ParallelForWithTaskContext(Contexts, RowCount, [&Layout, &AddedLights, &AddedDirectionals, &OutResult](FWorkerContext& Context, const int32 RowIndex)
+	{
+		const int32 Y = RowIndex % Layout.CellCount.Y;
+		const int32 Z = RowIndex / Layout.CellCount.Y;
+
+		// Only the lights whose attenuation sphere reaches this row are packed for the vector loop.
+		const FVector3f RowMin(0.0f, Y * Layout.CellSize.Y, Z * Layout.CellSize.Z);
+		const FVector3f RowMax(Layout.CellCount.X * Layout.CellSize.X, (Y + 1) * Layout.CellSize.Y, (Z + 1) * Layout.CellSize.Z);
+
+		FLightArrays& RowLights = Context.RowLights;
+		RowLights.Reset();
+
+		for (int32 LightIndex = 0; LightIndex < AddedLights.Num(); ++LightIndex)
+		{
+			if (AddedLights.Intensity[LightIndex] <= 0.0f) { continue; }
+
+			const FVector3f LightPosition(AddedLights.PosX[LightIndex], AddedLights.PosY[LightIndex], AddedLights.PosZ[LightIndex]);
+			const FVector3f Closest = LightPosition.BoundToBox(RowMin, RowMax);
+			if (FVector3f::DistSquared(Closest, LightPosition) <= AddedLights.RadiusSq[LightIndex])
+			{
+				RowLights.CopyFrom(AddedLights, LightIndex);
+			}
+		}
+		RowLights.PadToVectorWidth();
+
+		if (Layout.bTraceOcclusion && Context.PerLight.Num() < RowLights.Num())
+		{
+			Context.PerLight.SetNumUninitialized(RowLights.Num());
+		}
+
+		for (int32 X = 0; X < Layout.CellCount.X; ++X)
+		{
+			const int32 CellIndex = Layout.GetCellIndex(X, Y, Z);
+			const FVector3f LocalCenter = Layout.GetLocalCellCenter(X, Y, Z);
+			const FVector WorldCenter = Layout.Origin + FVector(LocalCenter);
+
+			float CellIlluminance = BEDarkSpotFinder::AccumulateLights(
+				RowLights.PosX.GetData(), RowLights.PosY.GetData(), RowLights.PosZ.GetData(),
+				RowLights.DirX.GetData(), RowLights.DirY.GetData(), RowLights.DirZ.GetData(),
+				RowLights.Intensity.GetData(), RowLights.InvRadiusSq.GetData(), RowLights.CosOuter.GetData(), RowLights.InvConeRange.GetData(),
+				RowLights.Num(), LocalCenter, Layout.bTraceOcclusion ? Context.PerLight.GetData() : nullptr);
+
+			if (Layout.bTraceOcclusion)
+			{
+				Context.SolidProbes.Add({ CellIndex, WorldCenter, 0.0f, true });
+
+				for (int32 Lane = 0; Lane < RowLights.Num(); ++Lane)
+				{
+					if (Context.PerLight[Lane] <= OcclusionEpsilon) { continue; }
+
+					const FVector LightLocation = Layout.Origin + FVector(RowLights.PosX[Lane], RowLights.PosY[Lane], RowLights.PosZ[Lane]);
+					Context.OcclusionTests.Add({ CellIndex, LightLocation, -Context.PerLight[Lane], false });
+				}
+			}
+
+			for (int32 Index = 0; Index < AddedDirectionals.Num(); ++Index)
+			{
+				CellIlluminance += AddedDirectionals.Illuminance[Index];
+
+				if (Layout.bTraceOcclusion)
+				{
+					Context.OcclusionTests.Add({ CellIndex, WorldCenter - AddedDirectionals.Directions[Index] * DirectionalTraceDistance, -AddedDirectionals.Illuminance[Index], false });
+				}
+			}
+
+			OutResult.Illuminance[CellIndex] = CellIlluminance;
+		}
+	});
+
+	MergeContexts(Contexts, OutResult);
+}
+
+void FBEDarkSpotFinder::EvaluateChanges(const FUpdateRequest& InRequest, FUpdateResult& OutResult)
+{
+	// Work is split into one slice of the grid per item, so a light covering the whole grid is still spread across the workers.
+	struct FSliceWork
+	{
+		const FLightArrays* SourceLights = nullptr;
+		int32 LightIndex = INDEX_NONE;
+		float Sign = 1.0f;
+		FIntVector MinCell = FIntVector::ZeroValue;
+		FIntVector MaxCell = FIntVector::ZeroValue;
+		int32 Z = 0;
+	};
+
+	TArray<FSliceWork> Work;
+
+	auto AddLightSlices = [&InRequest, &Work](const FLightArrays& InLights, const float InSign)
+	{
+		for (int32 LightIndex = 0; LightIndex < InLights.Num(); ++LightIndex)
+		{
+			FIntVector MinCell;
+			FIntVector MaxCell;
+			if (!GetLightCellRange(InRequest.Grid, InLights, LightIndex, MinCell, MaxCell)) { continue; }
+
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				Work.Add({ &InLights, LightIndex, InSign, MinCell, MaxCell, Z });
+			}
+		}
+	};
+
+	AddLightSlices(InRequest.Removed.Lights, -1.0f);
+	AddLightSlices(InRequest.Added.Lights, 1.0f);
+
+	// A directional light reaches every cell, so its change is applied slice by slice over the whole grid.
+	if (InRequest.Removed.Directionals.Num() > 0 || InRequest.Added.Directionals.Num() > 0)
+	{
+		for (int32 Z = 0; Z < InRequest.Grid.CellCount.Z; ++Z)
+		{
+			FSliceWork& DirectionalWork = Work.AddDefaulted_GetRef();
+			DirectionalWork.Z = Z;
+		}
+	}
+
+	TArray<FWorkerContext> Contexts;
+	ParallelForWithTaskContext(Contexts, Work.Num(), [&InRequest, &Work](FWorkerContext& Context, const int32 WorkIndex)
+	{
+		const FSliceWork& Slice = Work[WorkIndex];
+
+		if (Slice.SourceLights)
+		{
+			EvaluateLightSlice(InRequest.Grid, *Slice.SourceLights, Slice.LightIndex, Slice.Sign, Slice.MinCell, Slice.MaxCell, Slice.Z, Context);
+		}
+		else
+		{
+			EvaluateDirectionalSlice(InRequest, Slice.Z, Context);
+		}
+	});
+
+	MergeContexts(Contexts, OutResult);
+}
+
+void FBEDarkSpotFinder::EvaluateLightSlice(const FGridLayout& InGrid, const FLightArrays& InLights, const int32 InIndex, const float InSign,
+	const FIntVector& InMinCell, const FIntVector& InMaxCell, const int32 InZ, FWorkerContext& OutContext)
+{
+	const FVector LightLocation = InGrid.Origin + FVector(InLights.PosX[InIndex], InLights.PosY[InIndex], InLights.PosZ[InIndex]);
+
+	for (int32 Y = InMinCell.Y; Y <= InMaxCell.Y; ++Y)
+	{
+		for (int32 X = InMinCell.X; X <= InMaxCell.X; ++X)
+		{
+			const int32 CellIndex = InGrid.GetCellIndex(X, Y, InZ);
+			const float Contribution = EvaluateLight(InLights, InIndex, InGrid.GetLocalCellCenter(X, Y, InZ));
+			if (Contribution <= 0.0f) { continue; }
+
+			const float Delta = InSign * Contribution;
+			OutContext.DeltaCells.Add(CellIndex);
+			OutContext.Deltas.Add(Delta);
+
+			if (InGrid.bTraceOcclusion && Contribution > OcclusionEpsilon)
+			{
+				OutContext.OcclusionTests.Add({ CellIndex, LightLocation, -Delta, false });
+			}
+		}
+	}
+}
+
+void FBEDarkSpotFinder::EvaluateDirectionalSlice(const FUpdateRequest& InRequest, const int32 InZ, FWorkerContext& OutContext)
+{
+	const FGridLayout& Layout = InRequest.Grid;
+	const FDirectionalArrays& RemovedDirectionals = InRequest.Removed.Directionals;
+	const FDirectionalArrays& AddedDirectionals = InRequest.Added.Directionals;
+
+	for (int32 Y = 0; Y < Layout.CellCount.Y; ++Y)
+	{
+		for (int32 X = 0; X < Layout.CellCount.X; ++X)
+		{
+			const int32 CellIndex = Layout.GetCellIndex(X, Y, InZ);
+			const FVector WorldCenter = Layout.Origin + FVector(Layout.GetLocalCellCenter(X, Y, InZ));
+
+			float Delta = 0.0f;
+
+			for (int32 Index = 0; Index < RemovedDirectionals.Num(); ++Index)
+			{
+				Delta -= RemovedDirectionals.Illuminance[Index];
+
+				if (Layout.bTraceOcclusion)
+				{
+					OutContext.OcclusionTests.Add({ CellIndex, WorldCenter - RemovedDirectionals.Directions[Index] * DirectionalTraceDistance, RemovedDirectionals.Illuminance[Index], false });
+				}
+			}
+
+			for (int32 Index = 0; Index < AddedDirectionals.Num(); ++Index)
+			{
+				Delta += AddedDirectionals.Illuminance[Index];
+
+				if (Layout.bTraceOcclusion)
+				{
+					OutContext.OcclusionTests.Add({ CellIndex, WorldCenter - AddedDirectionals.Directions[Index] * DirectionalTraceDistance, -AddedDirectionals.Illuminance[Index], false });
+				}
+			}
+
+			OutContext.DeltaCells.Add(CellIndex);
+			OutContext.Deltas.Add(Delta);
+		}
+	}
+}
+
+bool FBEDarkSpotFinder::GetLightCellRange(const FGridLayout& InGrid, const FLightArrays& InLights, const int32 InIndex, FIntVector& OutMinCell, FIntVector& OutMaxCell)
+{
+	if (InLights.Intensity[InIndex] <= 0.0f) { return false; }
+
+	const FVector3f LightPosition(InLights.PosX[InIndex], InLights.PosY[InIndex], InLights.PosZ[InIndex]);
+	const float Radius = FMath::Sqrt(InLights.RadiusSq[InIndex]);
+
+	OutMinCell = FIntVector(
+		FMath::Clamp(FMath::FloorToInt((LightPosition.X - Radius) / InGrid.CellSize.X), 0, InGrid.CellCount.X - 1),
+		FMath::Clamp(FMath::FloorToInt((LightPosition.Y - Radius) / InGrid.CellSize.Y), 0, InGrid.CellCount.Y - 1),
+		FMath::Clamp(FMath::FloorToInt((LightPosition.Z - Radius) / InGrid.CellSize.Z), 0, InGrid.CellCount.Z - 1));
+	OutMaxCell = FIntVector(
+		FMath::Clamp(FMath::FloorToInt((LightPosition.X + Radius) / InGrid.CellSize.X), 0, InGrid.CellCount.X - 1),
+		FMath::Clamp(FMath::FloorToInt((LightPosition.Y + Radius) / InGrid.CellSize.Y), 0, InGrid.CellCount.Y - 1),
+		FMath::Clamp(FMath::FloorToInt((LightPosition.Z + Radius) / InGrid.CellSize.Z), 0, InGrid.CellCount.Z - 1));
+
+	return true;
+}
+
+float FBEDarkSpotFinder::EvaluateLight(const FLightArrays& InLights, const int32 InIndex, const FVector3f& InLocalPosition)
+{
+	const FVector3f Delta = InLocalPosition - FVector3f(InLights.PosX[InIndex], InLights.PosY[InIndex], InLights.PosZ[InIndex]);
+	const float DistanceSq = FMath::Max(Delta.SizeSquared(), MinDistanceSq);
+
+	const float Ratio = DistanceSq * InLights.InvRadiusSq[InIndex];
+	const float Window = FMath::Square(FMath::Max(1.0f - Ratio * Ratio, 0.0f));
+
+	const float CosAngle = (Delta | FVector3f(InLights.DirX[InIndex], InLights.DirY[InIndex], InLights.DirZ[InIndex])) * FMath::InvSqrt(DistanceSq);
+	const float Cone = FMath::Square(FMath::Clamp((CosAngle - InLights.CosOuter[InIndex]) * InLights.InvConeRange[InIndex], 0.0f, 1.0f));
+
+	return InLights.Intensity[InIndex] / DistanceSq * Window * Cone;
+}
+
+void FBEDarkSpotFinder::MergeContexts(TArray<FWorkerContext>& InContexts, FUpdateResult& OutResult)
+{
+	int32 DeltaCount = 0;
+	int32 TestCount = 0;
+	for (const FWorkerContext& Context : InContexts)
+	{
+		DeltaCount += Context.DeltaCells.Num();
+		TestCount += Context.SolidProbes.Num() + Context.OcclusionTests.Num();
+	}
+
+	OutResult.DeltaCells.Reserve(DeltaCount);
+	OutResult.Deltas.Reserve(DeltaCount);
+	OutResult.OcclusionTests.Reserve(TestCount);
+
+	// Solid probes go first, so the traces of cells that turn out to be solid can be skipped.
+	for (FWorkerContext& Context : InContexts)
+	{
+		OutResult.OcclusionTests.Append(MoveTemp(Context.SolidProbes));
+	}
+
+	for (FWorkerContext& Context : InContexts)
+	{
+		OutResult.DeltaCells.Append(MoveTemp(Context.DeltaCells));
+		OutResult.Deltas.Append(MoveTemp(Context.Deltas));
+		OutResult.OcclusionTests.Append(MoveTemp(Context.OcclusionTests));
+	}
+}
+
+bool FBEDarkSpotFinder::IsOccluded(const FVector& InFrom, const FVector& InTo) const
+{
+	if (!World.IsValid()) { return false; }
+
+	static const FName TraceTag(TEXT("BrightEyeDarkSpot"));
+	FCollisionQueryParams CollisionParams(TraceTag, SCENE_QUERY_STAT_ONLY(BrightEyeDarkSpot), false, IgnoredActor.Get());
+
+	return World->LineTraceTestByChannel(InFrom, InTo, ECC_Visibility, CollisionParams);
+}
+
+bool FBEDarkSpotFinder::IsSolid(const FVector& InLocation) const
+{
+	if (!World.IsValid()) { return false; }
+
+	const FCollisionShape Probe = FCollisionShape::MakeSphere(Grid.CellSize.GetMin() * 0.1f);
+	return World->OverlapAnyTestByChannel(InLocation, FQuat::Identity, ECC_Visibility, Probe);
+}
+
+bool FBEDarkSpotFinder::ShouldGatherLight(const ULightComponent* InLight) const
+{
+	if (!IsValid(InLight) || !InLight->IsRegistered() || !InLight->bAffectsWorld || InLight->Intensity <= 0.0f) { return false; }
+
+	if (InLight->GetWorld() != World.Get() || !InLight->IsVisibleInEditor()) { return false; }
+
+	return InLight->GetOwner() != IgnoredActor.Get();
+}
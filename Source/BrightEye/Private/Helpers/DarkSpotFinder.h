@@ -0,0 +1,179 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+class AActor;
+class ULightComponent;
+class ULineBatchComponent;
+struct FConvexVolume;
+
+/**
+ * FBEDarkSpotFinder estimates direct illuminance on a coarse 3D grid from the level's light components.
+ * Lights are gathered on the game thread into a snapshot and the grid is evaluated from it on the thread pool,
+ * four local lights at a time. A changed light, local or directional, only applies the difference between its old and new contribution.
+ * Occlusion traces are queued by the workers and run in parallel batches that the game thread waits on, under a per-frame trace budget.
+ */
+class FBEDarkSpotFinder
+{
+public:
+	void Build(UWorld* InWorld, const FBox& InBounds, int32 InResolution, bool bInTraceOcclusion, const AActor* InIgnoredActor);
+	void Reset();
+
+	void MarkLightDirty(const ULightComponent* InLight);
+	void MarkActorDirty(const AActor* InActor);
+	void RemoveActorLights(const AActor* InActor);
+
+	// Collects finished updates, starts the next one and resolves queued occlusion traces. Returns true when the grid settled on new values.
+	bool Tick(int32 InOcclusionTraceBudget);
+
+	bool FindDarkestCell(const FConvexVolume* InViewFrustum, FVector& OutLocation) const;
+	void DrawUnderLitCells(ULineBatchComponent* InLineBatcher, float InThreshold) const;
+
+	bool IsBuilt() const { return Grid.Num() > 0; }
+	bool IsReady() const { return Illuminance.Num() > 0 && !PendingUpdate.IsValid() && !HasPendingOcclusion(); }
+	bool HasDirtyLights() const { return DirtyLights.Num() > 0 || StagedRemovals.Lights.Num() > 0 || StagedRemovals.Directionals.Num() > 0; }
+	bool NeedsTick() const { return IsBuilt() && (PendingUpdate.IsValid() || HasDirtyLights() || HasPendingOcclusion()); }
+
+private:
+	struct FGridLayout
+	{
+		FVector Origin = FVector::ZeroVector;
+		FVector3f CellSize = FVector3f::ZeroVector;
+		FIntVector CellCount = FIntVector::ZeroValue;
+		bool bTraceOcclusion = false;
+
+		int32 Num() const { return CellCount.X * CellCount.Y * CellCount.Z; }
+		int32 GetCellIndex(int32 InX, int32 InY, int32 InZ) const { return InX + CellCount.X * (InY + CellCount.Y * InZ); }
+		FVector3f GetLocalCellCenter(int32 InX, int32 InY, int32 InZ) const;
+		FVector3f GetLocalCellCenter(int32 InCellIndex) const;
+	};
+
+	struct FLightArrays
+	{
+		TArray<float> PosX, PosY, PosZ;
+		TArray<float> DirX, DirY, DirZ;
+		TArray<float> Intensity;
+		TArray<float> RadiusSq;
+		TArray<float> InvRadiusSq;
+		TArray<float> CosOuter;
+		TArray<float> InvConeRange;
+		TArray<int32> SourceIndex;
+
+		int32 Num() const { return Intensity.Num(); }
+		void Reset();
+		void AddDefaulted();
+		void CopyFrom(const FLightArrays& InOther, int32 InIndex);
+		void PadToVectorWidth();
+	};
+
+	struct FDirectionalArrays
+	{
+		TArray<FVector> Directions;
+		TArray<float> Illuminance;
+
+		int32 Num() const { return Illuminance.Num(); }
+		void Reset();
+		void Add(const FVector& InDirection, float InIlluminance);
+	};
+
+	// Lights whose contribution is removed from or added to the grid by one update.
+	struct FLightChanges
+	{
+		FLightArrays Lights;
+		FDirectionalArrays Directionals;
+
+		void Reset();
+	};
+
+	// A segment from a cell center, traced in a parallel batch that the game thread waits on. Blocked segments add the correction to the cell.
+	struct FOcclusionTest
+	{
+		int32 CellIndex = INDEX_NONE;
+		FVector To = FVector::ZeroVector;
+		float Correction = 0.0f;
+		bool bIsSolidProbe = false;
+	};
+
+	struct FUpdateRequest
+	{
+		FGridLayout Grid;
+		FLightChanges Removed;
+		FLightChanges Added;
+		bool bIsFullBuild = false;
+	};
+
+	struct FUpdateResult
+	{
+		bool bIsFullBuild = false;
+		TArray<float> Illuminance;
+		TArray<int32> DeltaCells;
+		TArray<float> Deltas;
+		TArray<FOcclusionTest> OcclusionTests;
+	};
+
+	// Scratch that each worker allocates once and reuses for every row or light it picks up.
+	struct FWorkerContext
+	{
+		FLightArrays RowLights;
+		TArray<float> PerLight;
+		TArray<int32> DeltaCells;
+		TArray<float> Deltas;
+		TArray<FOcclusionTest> SolidProbes;
+		TArray<FOcclusionTest> OcclusionTests;
+	};
+
+	using FUpdateResultPtr = TSharedPtr<FUpdateResult, ESPMode::ThreadSafe>;
+
+	void GatherLights(FLightChanges& OutAdded);
+	void AddLight(const ULightComponent* InLight, FLightChanges& OutAdded);
+	bool GatherLight(const ULightComponent* InLight, int32 InIndex);
+	bool GatherDirectionalLight(const ULightComponent* InLight, int32 InIndex);
+	void ClearLight(int32 InIndex);
+	void ClearDirectionalLight(int32 InIndex);
+	void CollectDirtyLights(FUpdateRequest& OutRequest);
+
+	void StartUpdate(FUpdateRequest&& InRequest);
+	bool ApplyFinishedUpdate();
+	bool ResolveOcclusionTests(int32 InTraceBudget);
+	bool HasPendingOcclusion() const { return NextOcclusionTest < OcclusionTests.Num(); }
+
+	static FUpdateResultPtr RunUpdate(const FUpdateRequest& InRequest);
+	static void EvaluateAllCells(const FUpdateRequest& InRequest, FUpdateResult& OutResult);
+	static void EvaluateChanges(const FUpdateRequest& InRequest, FUpdateResult& OutResult);
+	static void EvaluateLightSlice(const FGridLayout& InGrid, const FLightArrays& InLights, int32 InIndex, float InSign, const FIntVector& InMinCell, const FIntVector& InMaxCell, int32 InZ, FWorkerContext& OutContext);
+	static void EvaluateDirectionalSlice(const FUpdateRequest& InRequest, int32 InZ, FWorkerContext& OutContext);
+	static bool GetLightCellRange(const FGridLayout& InGrid, const FLightArrays& InLights, int32 InIndex, FIntVector& OutMinCell, FIntVector& OutMaxCell);
+	static float EvaluateLight(const FLightArrays& InLights, int32 InIndex, const FVector3f& InLocalPosition);
+	static void MergeContexts(TArray<FWorkerContext>& InContexts, FUpdateResult& OutResult);
+
+	bool IsOccluded(const FVector& InFrom, const FVector& InTo) const;
+	bool IsSolid(const FVector& InLocation) const;
+	bool ShouldGatherLight(const ULightComponent* InLight) const;
+
+	TWeakObjectPtr<UWorld> World;
+	TWeakObjectPtr<const AActor> IgnoredActor;
+	FGridLayout Grid;
+
+	TArray<float> Illuminance;
+	TBitArray<> SolidCells;
+
+	// Game thread record of what has been applied to the grid or is on its way there.
+	FLightArrays Lights;
+	TArray<TWeakObjectPtr<const ULightComponent>> LightSources;
+	TMap<TWeakObjectPtr<const ULightComponent>, int32> LightIndices;
+
+	FDirectionalArrays Directionals;
+	TArray<TWeakObjectPtr<const ULightComponent>> DirectionalSources;
+	TMap<TWeakObjectPtr<const ULightComponent>, int32> DirectionalIndices;
+
+	TSet<TWeakObjectPtr<const ULightComponent>> DirtyLights;
+	FLightChanges StagedRemovals;
+
+	TFuture<FUpdateResultPtr> PendingUpdate;
+	TArray<FOcclusionTest> OcclusionTests;
+	int32 NextOcclusionTest = 0;
+};
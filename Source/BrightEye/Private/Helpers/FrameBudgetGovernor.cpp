@@ -0,0 +1,63 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "FrameBudgetGovernor.h"
+
+constexpr double CostSmoothing = 0.1;
+constexpr double RecoveryFraction = 0.5;
+constexpr float DegradeCooldown = 0.5f;
+constexpr float RecoveryTime = 2.0f;
+
+bool FBEFrameBudgetGovernor::Update(const double InTickMilliseconds, const float InDeltaTime, const float InBudgetMilliseconds)
+{
+	SmoothedCost = FMath::Lerp(SmoothedCost, InTickMilliseconds, CostSmoothing);
+	TimeSinceLevelChange += InDeltaTime;
+
+	const EBEDegradationLevel PreviousLevel = Level;
+
+	if (InBudgetMilliseconds <= 0.0f)
+	{
+		// A zero budget turns the governor off.
+		Level = EBEDegradationLevel::None;
+		TimeUnderRecoveryLine = 0.0f;
+	}
+	else if (SmoothedCost > InBudgetMilliseconds)
+	{
+		TimeUnderRecoveryLine = 0.0f;
+
+		if (Level != EBEDegradationLevel::DeferPanelAndConfig && TimeSinceLevelChange >= DegradeCooldown)
+		{
+			Level = static_cast<EBEDegradationLevel>(static_cast<uint8>(Level) + 1);
+		}
+	}
+	else if (SmoothedCost < InBudgetMilliseconds * RecoveryFraction)
+	{
+		TimeUnderRecoveryLine += InDeltaTime;
+
+		if (Level != EBEDegradationLevel::None && TimeUnderRecoveryLine >= RecoveryTime)
+		{
+			Level = static_cast<EBEDegradationLevel>(static_cast<uint8>(Level) - 1);
+			TimeUnderRecoveryLine = 0.0f;
+		}
+	}
+	else
+	{
+		TimeUnderRecoveryLine = 0.0f;
+	}
+
+	if (Level != PreviousLevel)
+	{
+		TimeSinceLevelChange = 0.0f;
+		return true;
+	}
+
+	return false;
+}
+
+void FBEFrameBudgetGovernor::Reset()
+{
+	Level = EBEDegradationLevel::None;
+	SmoothedCost = 0.0;
+	TimeSinceLevelChange = 0.0f;
+	TimeUnderRecoveryLine = 0.0f;
+}
@@ -0,0 +1,38 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Degradation steps, in the order they are applied when the tick runs over budget. */
+enum class EBEDegradationLevel : uint8
+{
+	None,
+	ReducedTraceRate,
+	SkipSmoothingSubsteps,
+	DeferPanelAndConfig
+};
+
+/**
+ * FBEFrameBudgetGovernor watches the measured cost of the Bright Eye tick against a per-frame budget.
+ * It steps one degradation level up while the smoothed cost stays over budget, and one level down
+ * after the cost has stayed well under budget for a while, so it does not flip between levels every frame.
+ */
+class FBEFrameBudgetGovernor
+{
+public:
+	// Returns true when the degradation level changed.
+	bool Update(double InTickMilliseconds, float InDeltaTime, float InBudgetMilliseconds);
+	void Reset();
+
+	EBEDegradationLevel GetLevel() const { return Level; }
+	bool IsAtLeast(EBEDegradationLevel InLevel) const { return Level >= InLevel; }
+	double GetSmoothedCost() const { return SmoothedCost; }
+
+private:
+	EBEDegradationLevel Level = EBEDegradationLevel::None;
+	double SmoothedCost = 0.0;
+	float TimeSinceLevelChange = 0.0f;
+	float TimeUnderRecoveryLine = 0.0f;
+};
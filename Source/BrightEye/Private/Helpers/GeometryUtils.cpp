@@ -2,42 +2,287 @@
 
 
 #include "GeometryUtils.h"
+#include "ConvexVolume.h"
 #include "LevelEditorViewport.h"
+#include "Async/ParallelFor.h"
+#include "System/BrightEyeStats.h"
 
 constexpr float MaxTraceDistance = 50000.0f;
 constexpr float DefaultForwardDistance = 2000.0f;
 constexpr float AlternativeTraceDistance = 3000.0f;
 
-FRotator FGeometryUtils::AdjustLightRotationFromTrace(const FVector& InViewLocation,const FRotator& InViewRotation, const FVector& InLightLocation)
+constexpr int32 MaxTracesPerFlush = 16;
+constexpr int32 MinParallelTraces = 2;
+constexpr float DuplicateStartToleranceSquared = 1.0f;
+constexpr float DuplicateDirectionDot = 0.99999f;
+
+namespace BEGeometryUtils
 {
-    UWorld* World  = GEditor->GetEditorWorldContext().World();
-    if(!IsValid(World)){ return InViewRotation; }
-    
-    FVector TraceEnd = InViewLocation + (InViewRotation.Vector() * MaxTraceDistance);
+    struct FTraceRequest
+    {
+        FVector Start = FVector::ZeroVector;
+        FVector Direction = FVector::ForwardVector;
+        float Length = 0.0f;
+        EBETracePriority Priority = EBETracePriority::Normal;
+    };
 
-    FHitResult HitResult;
-    FCollisionQueryParams CollisionParams;
-    CollisionParams.bReturnPhysicalMaterial = false;
+    struct FResolvedTrace
+    {
+        FBETraceResult Result;
+        bool bTraced = false;
+    };
 
-    bool bHit = World->LineTraceSingleByChannel(HitResult, InViewLocation, TraceEnd, ECC_Visibility, CollisionParams);
+    /** Rays queued since the last flush and the results of that flush. The arrays keep their capacity between frames. */
+    struct FTraceBroker
+    {
+        TArray<FTraceRequest> Requests;
+        TArray<FResolvedTrace> Results;
+        TArray<int32> Order;
+        uint32 PendingGeneration = 1;
+        uint32 ResolvedGeneration = 0;
+        int32 SubmittedCount = 0;
+        int32 LastSubmittedCount = 0;
+        int32 LastTracedCount = 0;
+    };
+
+    FTraceBroker TraceBroker;
 
-    if (bHit && HitResult.bBlockingHit)
+    const FCollisionQueryParams& GetTraceQueryParams()
     {
-        return (HitResult.ImpactPoint - InLightLocation).Rotation();
+        static const FCollisionQueryParams QueryParams = []()
+        {
+            FCollisionQueryParams Params(SCENE_QUERY_STAT(BrightEyeTrace), false);
+            Params.bReturnPhysicalMaterial = false;
+            return Params;
+        }();
+        return QueryParams;
     }
 
-    return (InLightLocation + InViewRotation.Vector() * DefaultForwardDistance - InLightLocation).Rotation();
+    /** Last hit distance along a trace ray, reused while traces are being skipped or are still queued. */
+    struct FTraceCache
+    {
+        float Distance = 0.0f;
+        bool bHit = false;
+        int32 CallsSinceTrace = 0;
+        bool bIsValid = false;
+        FBETraceHandle PendingTrace;
+
+        bool ShouldTrace(const int32 InInterval)
+        {
+            if (!bIsValid || ++CallsSinceTrace >= InInterval)
+            {
+                CallsSinceTrace = 0;
+                return true;
+            }
+            return false;
+        }
+
+        void Store(const bool bInHit, const float InDistance)
+        {
+            bHit = bInHit;
+            Distance = InDistance;
+            bIsValid = true;
+        }
+
+        // Picks up the ray resolved by the last flush. A ray that was dropped or missed its flush is given up.
+        void Resolve()
+        {
+            if (!PendingTrace.IsValid() || PendingTrace.Generation == TraceBroker.PendingGeneration) { return; }
+
+            FBETraceResult Result;
+            if (FGeometryUtils::GetTraceResult(PendingTrace, Result))
+            {
+                Store(Result.bHit, Result.Distance);
+            }
+            PendingTrace.Reset();
+        }
+
+        // Queues a new ray when one is due. The first ray has nothing to fall back on, so it is flushed right away.
+        void Request(const FVector& InStart, const FVector& InDirection, const EBETracePriority InPriority, const int32 InInterval)
+        {
+            Resolve();
+
+            if (PendingTrace.IsValid() || !ShouldTrace(InInterval)) { return; }
+
+            PendingTrace = FGeometryUtils::SubmitTrace(InStart, InDirection, MaxTraceDistance, InPriority);
+
+            if (!bIsValid)
+            {
+                FGeometryUtils::FlushTraces();
+                Resolve();
+            }
+        }
+    };
+
+    int32 TraceInterval = 1;
+    FTraceCache ViewTraceCache;
+    FTraceCache MouseTraceCache;
+
+    FVector LastHitLocation = FVector::ZeroVector;
+    uint64 LastHitFrame = 0;
+    bool bHasLastHit = false;
+
+    void RecordHit(const FVector& InHitLocation)
+    {
+        LastHitLocation = InHitLocation;
+        LastHitFrame = GFrameCounter;
+        bHasLastHit = true;
+    }
 }
 
+void FGeometryUtils::SetTraceInterval(const int32 InInterval)
+{
+    BEGeometryUtils::TraceInterval = FMath::Max(InInterval, 1);
+}
 
-bool FGeometryUtils::GetHitLocationFromCameraAndMouse(FVector& OutHitLocation)
+bool FGeometryUtils::GetLastTraceHit(FVector& OutHitLocation)
 {
-    UWorld* World = GEditor->GetEditorWorldContext().World();
-    if (!World)
+    if (!BEGeometryUtils::bHasLastHit || GFrameCounter - BEGeometryUtils::LastHitFrame > 1)
     {
         return false;
     }
 
+    OutHitLocation = BEGeometryUtils::LastHitLocation;
+    return true;
+}
+
+FBETraceHandle FGeometryUtils::SubmitTrace(const FVector& InStart, const FVector& InDirection, const float InLength, const EBETracePriority InPriority)
+{
+    check(IsInGameThread());
+
+    BEGeometryUtils::FTraceBroker& Broker = BEGeometryUtils::TraceBroker;
+    const FVector Direction = InDirection.GetSafeNormal();
+
+    ++Broker.SubmittedCount;
+
+    FBETraceHandle Handle;
+    Handle.Generation = Broker.PendingGeneration;
+
+    // Callers tracing the same view ray in one frame share a single trace.
+    for (int32 Index = 0; Index < Broker.Requests.Num(); ++Index)
+    {
+        BEGeometryUtils::FTraceRequest& Request = Broker.Requests[Index];
+        if (FVector::DistSquared(Request.Start, InStart) <= DuplicateStartToleranceSquared && (Request.Direction | Direction) >= DuplicateDirectionDot)
+        {
+            Request.Length = FMath::Max(Request.Length, InLength);
+            Request.Priority = FMath::Max(Request.Priority, InPriority);
+
+            Handle.Index = Index;
+            return Handle;
+        }
+    }
+
+    BEGeometryUtils::FTraceRequest& Request = Broker.Requests.AddDefaulted_GetRef();
+    Request.Start = InStart;
+    Request.Direction = Direction;
+    Request.Length = InLength;
+    Request.Priority = InPriority;
+
+    Handle.Index = Broker.Requests.Num() - 1;
+    return Handle;
+}
+
+void FGeometryUtils::FlushTraces()
+{
+    check(IsInGameThread());
+    SCOPE_CYCLE_COUNTER(STAT_BrightEyeTraceFlush);
+
+    BEGeometryUtils::FTraceBroker& Broker = BEGeometryUtils::TraceBroker;
+
+    Broker.Results.Reset();
+    Broker.Results.SetNum(Broker.Requests.Num());
+    Broker.Order.Reset();
+
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (IsValid(World) && Broker.Requests.Num() > 0)
+    {
+        for (int32 Index = 0; Index < Broker.Requests.Num(); ++Index)
+        {
+            Broker.Order.Add(Index);
+        }
+
+        // Low priority rays are the first to go when more are queued than a flush may trace.
+        Broker.Order.StableSort([&Broker](const int32 A, const int32 B)
+        {
+            return Broker.Requests[A].Priority > Broker.Requests[B].Priority;
+        });
+        Broker.Order.SetNum(FMath::Min(Broker.Order.Num(), MaxTracesPerFlush));
+
+        const FCollisionQueryParams& QueryParams = BEGeometryUtils::GetTraceQueryParams();
+
+        ParallelFor(Broker.Order.Num(), [&Broker, World, &QueryParams](const int32 OrderIndex)
+        {
+            const int32 RequestIndex = Broker.Order[OrderIndex];
+            const BEGeometryUtils::FTraceRequest& Request = Broker.Requests[RequestIndex];
+
+            FHitResult HitResult;
+            const bool bHit = World->LineTraceSingleByChannel(HitResult, Request.Start, Request.Start + Request.Direction * Request.Length, ECC_Visibility, QueryParams);
+
+            BEGeometryUtils::FResolvedTrace& Resolved = Broker.Results[RequestIndex];
+            Resolved.Result.bHit = bHit && HitResult.bBlockingHit;
+            Resolved.Result.Distance = HitResult.Distance;
+            Resolved.bTraced = true;
+        }, Broker.Order.Num() < MinParallelTraces ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+    }
+
+    Broker.LastSubmittedCount = Broker.SubmittedCount;
+    Broker.LastTracedCount = Broker.Order.Num();
+    INC_DWORD_STAT_BY(STAT_BrightEyeTracesSubmitted, Broker.LastSubmittedCount);
+    INC_DWORD_STAT_BY(STAT_BrightEyeTracesExecuted, Broker.LastTracedCount);
+
+    Broker.Requests.Reset();
+    Broker.SubmittedCount = 0;
+    Broker.ResolvedGeneration = Broker.PendingGeneration++;
+}
+
+bool FGeometryUtils::GetTraceResult(const FBETraceHandle& InHandle, FBETraceResult& OutResult)
+{
+    const BEGeometryUtils::FTraceBroker& Broker = BEGeometryUtils::TraceBroker;
+
+    if (!InHandle.IsValid() || InHandle.Generation != Broker.ResolvedGeneration || !Broker.Results.IsValidIndex(InHandle.Index)) { return false; }
+
+    const BEGeometryUtils::FResolvedTrace& Resolved = Broker.Results[InHandle.Index];
+    if (!Resolved.bTraced) { return false; }
+
+    OutResult = Resolved.Result;
+    return true;
+}
+
+void FGeometryUtils::GetTraceCounts(int32& OutSubmitted, int32& OutTraced)
+{
+    OutSubmitted = BEGeometryUtils::TraceBroker.LastSubmittedCount;
+    OutTraced = BEGeometryUtils::TraceBroker.LastTracedCount;
+}
+
+constexpr float LightBehindViewDistance = 20.0f;
+
+FVector FGeometryUtils::GetLightLocationFromView(const FVector& InViewLocation, const FRotator& InViewRotation, const FVector2D& InViewOffset)
+{
+    const FQuat ViewQuat = InViewRotation.Quaternion();
+
+    return InViewLocation + ViewQuat.GetUpVector() * InViewOffset.Y + ViewQuat.GetRightVector() * InViewOffset.X - ViewQuat.GetForwardVector() * LightBehindViewDistance;
+}
+
+FRotator FGeometryUtils::AdjustLightRotationFromTrace(const FVector& InViewLocation,const FRotator& InViewRotation, const FVector& InLightLocation)
+{
+    BEGeometryUtils::FTraceCache& Cache = BEGeometryUtils::ViewTraceCache;
+
+    Cache.Request(InViewLocation, InViewRotation.Vector(), EBETracePriority::High, BEGeometryUtils::TraceInterval);
+
+    if (Cache.bHit)
+    {
+        const FVector HitLocation = InViewLocation + InViewRotation.Vector() * Cache.Distance;
+        BEGeometryUtils::RecordHit(HitLocation);
+
+        return (HitLocation - InLightLocation).Rotation();
+    }
+
+    return (InLightLocation + InViewRotation.Vector() * DefaultForwardDistance - InLightLocation).Rotation();
+}
+
+
+bool FGeometryUtils::GetHitLocationFromCameraAndMouse(FVector& OutHitLocation)
+{
     FLevelEditorViewportClient* ViewportClient = GCurrentLevelEditingViewportClient;
     if (!ViewportClient || !ViewportClient->Viewport)
     {
@@ -50,19 +295,76 @@ bool FGeometryUtils::GetHitLocationFromCameraAndMouse(FVector& OutHitLocation)
     FVector MouseWorldDirection = ViewportClient->GetCursorWorldLocationFromMousePos().GetDirection();
     FVector Direction = MouseWorldDirection;
 
-    FHitResult HitResult;
-    FVector TraceEnd = CameraBackwardLocation + (Direction * MaxTraceDistance);
-    FCollisionQueryParams CollisionParams;
-    CollisionParams.bReturnPhysicalMaterial = false;
+    BEGeometryUtils::FTraceCache& Cache = BEGeometryUtils::MouseTraceCache;
 
-    bool bHit = World->LineTraceSingleByChannel(HitResult, CameraBackwardLocation, TraceEnd, ECC_Visibility, CollisionParams);
+    Cache.Request(CameraBackwardLocation, Direction, EBETracePriority::Normal, BEGeometryUtils::TraceInterval);
 
-    if (bHit && HitResult.bBlockingHit)
+    if (Cache.bHit)
     {
-        OutHitLocation = HitResult.Location;
+        OutHitLocation = CameraBackwardLocation + (Direction * Cache.Distance);
+        BEGeometryUtils::RecordHit(OutHitLocation);
         return true;
     }
 
     OutHitLocation = CameraBackwardLocation + (Direction * AlternativeTraceDistance);
     return false;
 }
+
+bool FGeometryUtils::GetViewFrustum(const FEditorViewportClient* InViewportClient, FConvexVolume& OutFrustum)
+{
+    if (!InViewportClient || !InViewportClient->Viewport || !InViewportClient->IsPerspective())
+    {
+        return false;
+    }
+
+    const FIntPoint ViewportSize = InViewportClient->Viewport->GetSizeXY();
+    if (ViewportSize.X <= 0 || ViewportSize.Y <= 0)
+    {
+        return false;
+    }
+
+    // Same view basis swizzle the renderer uses, so the planes match what is actually on screen.
+    const FMatrix ViewRotationMatrix = FInverseRotationMatrix(InViewportClient->GetViewRotation()) * FMatrix(
+        FPlane(0, 0, 1, 0),
+        FPlane(1, 0, 0, 0),
+        FPlane(0, 1, 0, 0),
+        FPlane(0, 0, 0, 1));
+    const FMatrix ViewMatrix = FTranslationMatrix(-InViewportClient->GetViewLocation()) * ViewRotationMatrix;
+
+    const float HalfFOV = FMath::DegreesToRadians(InViewportClient->ViewFOV) * 0.5f;
+    const FMatrix ProjectionMatrix = FReversedZPerspectiveMatrix(HalfFOV, ViewportSize.X, ViewportSize.Y, GNearClippingPlane);
+
+    GetViewFrustumBounds(OutFrustum, ViewMatrix * ProjectionMatrix, false);
+    return true;
+}
+
+bool FGeometryUtils::GetViewBounds(const FEditorViewportClient* InViewportClient, const float InDepth, FBox& OutBounds)
+{
+    if (!InViewportClient || !InViewportClient->Viewport || !InViewportClient->IsPerspective())
+    {
+        return false;
+    }
+
+    const FIntPoint ViewportSize = InViewportClient->Viewport->GetSizeXY();
+    if (ViewportSize.X <= 0 || ViewportSize.Y <= 0)
+    {
+        return false;
+    }
+
+    const FVector ViewLocation = InViewportClient->GetViewLocation();
+    const FQuat ViewQuat = InViewportClient->GetViewRotation().Quaternion();
+
+    const float TanHalfFOVX = FMath::Tan(FMath::DegreesToRadians(InViewportClient->ViewFOV) * 0.5f);
+    const float TanHalfFOVY = TanHalfFOVX * ViewportSize.Y / ViewportSize.X;
+
+    const FVector FarCenter = ViewLocation + ViewQuat.GetForwardVector() * InDepth;
+    const FVector FarRight = ViewQuat.GetRightVector() * (InDepth * TanHalfFOVX);
+    const FVector FarUp = ViewQuat.GetUpVector() * (InDepth * TanHalfFOVY);
+
+    OutBounds = FBox(ViewLocation, ViewLocation);
+    OutBounds += FarCenter + FarRight + FarUp;
+    OutBounds += FarCenter + FarRight - FarUp;
+    OutBounds += FarCenter - FarRight + FarUp;
+    OutBounds += FarCenter - FarRight - FarUp;
+    return true;
+}
@@ -5,6 +5,32 @@
 
 #include "CoreMinimal.h"
 
+class FEditorViewportClient;
+struct FConvexVolume;
+
+enum class EBETracePriority : uint8
+{
+    Low,
+    Normal,
+    High
+};
+
+/** Refers to a ray submitted to the trace broker. It resolves with the flush that follows its submission. */
+struct FBETraceHandle
+{
+    int32 Index = INDEX_NONE;
+    uint32 Generation = 0;
+
+    bool IsValid() const { return Index != INDEX_NONE; }
+    void Reset() { Index = INDEX_NONE; }
+};
+
+struct FBETraceResult
+{
+    bool bHit = false;
+    float Distance = 0.0f;
+};
+
 /**
  * FGeometryUtils provides utility functions for geometry calculations and editor viewport interactions.
  */
@@ -13,6 +39,27 @@ class BRIGHTEYE_API FGeometryUtils
 {
 public:
 
+ static FVector GetLightLocationFromView(const FVector& InViewLocation, const FRotator& InViewRotation, const FVector2D& InViewOffset);
  static FRotator AdjustLightRotationFromTrace(const FVector& InViewLocation,const FRotator& InViewRotation, const FVector& InLightLocation);
  static bool GetHitLocationFromCameraAndMouse(FVector& OutHitLocation);
+ static bool GetViewFrustum(const FEditorViewportClient* InViewportClient, FConvexVolume& OutFrustum);
+ static bool GetViewBounds(const FEditorViewportClient* InViewportClient, float InDepth, FBox& OutBounds);
+
+ // Traces only run on every Nth call; the calls in between reuse the last hit distance along the current ray.
+ static void SetTraceInterval(int32 InInterval);
+
+ // Returns the blocking hit found by the light traces during the current or previous frame, without tracing again.
+ static bool GetLastTraceHit(FVector& OutHitLocation);
+
+ // Queues a visibility ray for the frame's batch. Identical or nearly identical rays share one trace and one handle.
+ static FBETraceHandle SubmitTrace(const FVector& InStart, const FVector& InDirection, float InLength, EBETracePriority InPriority);
+
+ // Traces all queued rays against the editor world as one parallel batch, highest priority first.
+ static void FlushTraces();
+
+ // Reads a ray resolved by the last flush. Fails while the ray is still queued, or if it was dropped or has gone stale.
+ static bool GetTraceResult(const FBETraceHandle& InHandle, FBETraceResult& OutResult);
+
+ // Rays submitted to the last flush, and the rays it actually traced after deduplication and the per-flush cap.
+ static void GetTraceCounts(int32& OutSubmitted, int32& OutTraced);
 };
@@ -0,0 +1,275 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "LightCostEstimator.h"
+#include "Async/Async.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SpotLightComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "Data/BrightEyeActor.h"
+
+constexpr float MinQueryInterval = 0.25f;
+constexpr float QueryMoveThreshold = 50.0f;
+constexpr float QueryAngleThresholdCos = 0.99939f; // ~2 degrees
+constexpr float QueryShapeThreshold = 0.01f;
+
+bool FBELightCostEstimator::Tick(const float InDeltaTime, UWorld* InWorld, const USpotLightComponent* InLight, const float InAttenuationRadius, const int32 InPrimitiveBudget)
+{
+	bool bHasNewResult = false;
+
+	if (PendingQuery.IsValid() && PendingQuery.IsReady())
+	{
+		Result = PendingQuery.Get();
+		PendingQuery = TFuture<FBELightCostResult>();
+		bHasNewResult = true;
+	}
+
+	TimeSinceLastQuery += InDeltaTime;
+
+	if (PendingQuery.IsValid() || TimeSinceLastQuery < MinQueryInterval || !IsValid(InWorld) || !IsValid(InLight))
+	{
+		return bHasNewResult;
+	}
+
+	FQueryPose Pose;
+	Pose.Location = InLight->GetComponentLocation();
+	Pose.Direction = InLight->GetDirection();
+	Pose.OuterConeAngle = InLight->OuterConeAngle;
+	Pose.AttenuationRadius = InAttenuationRadius;
+	Pose.PrimitiveBudget = InPrimitiveBudget;
+
+	const bool bIsSceneDirty = IsSceneDirty(InWorld);
+	if (!bIsSceneDirty && !HasPoseChanged(Pose)) { return bHasNewResult; }
+
+	if (bIsSceneDirty)
+	{
+		RefreshSnapshot(InWorld);
+	}
+
+	LastQueryPose = Pose;
+	bHasQueried = true;
+	TimeSinceLastQuery = 0.0f;
+
+	TSharedPtr<const FPrimitiveSnapshot, ESPMode::ThreadSafe> QuerySnapshot = Snapshot;
+	PendingQuery = Async(EAsyncExecution::ThreadPool, [QuerySnapshot, Pose]()
+	{
+		return RunQuery(*QuerySnapshot, Pose);
+	});
+
+	return bHasNewResult;
+}
+
+void FBELightCostEstimator::Reset()
+{
+	// A running query only holds its own snapshot reference, so it can finish on its own.
+	PendingQuery = TFuture<FBELightCostResult>();
+	Snapshot.Reset();
+	SnapshotWorld.Reset();
+	ActorPrimitives.Reset();
+	DirtyActors.Reset();
+	bHasRemovedActors = false;
+	bHasQueried = false;
+	Result = FBELightCostResult();
+}
+
+void FBELightCostEstimator::MarkActorDirty(const AActor* InActor)
+{
+	if (!HasSnapshot() || !IsValid(InActor) || InActor->GetWorld() != SnapshotWorld.Get()) { return; }
+
+	DirtyActors.Add(InActor);
+}
+
+void FBELightCostEstimator::RemoveActor(const AActor* InActor)
+{
+	if (!HasSnapshot() || !InActor) { return; }
+
+	DirtyActors.Remove(InActor);
+	bHasRemovedActors |= ActorPrimitives.Remove(InActor) > 0;
+}
+
+bool FBELightCostEstimator::IsSceneDirty(const UWorld* InWorld) const
+{
+	return !Snapshot.IsValid() || SnapshotWorld.Get() != InWorld || DirtyActors.Num() > 0 || bHasRemovedActors;
+}
+
+void FBELightCostEstimator::RefreshSnapshot(UWorld* InWorld)
+{
+	// The whole world is only walked when it changes; after that, actor events keep the per-actor entries current.
+	if (SnapshotWorld.Get() != InWorld)
+	{
+		ActorPrimitives.Reset();
+		DirtyActors.Reset();
+
+		for (TActorIterator<AActor> It(InWorld); It; ++It)
+		{
+			GatherActor(*It);
+		}
+
+		SnapshotWorld = InWorld;
+	}
+	else
+	{
+		for (const TWeakObjectPtr<const AActor>& DirtyActor : DirtyActors)
+		{
+			GatherActor(DirtyActor.Get());
+		}
+		DirtyActors.Reset();
+	}
+
+	TSharedPtr<FPrimitiveSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FPrimitiveSnapshot, ESPMode::ThreadSafe>();
+
+	int32 EntryCount = 0;
+	for (const TPair<TObjectKey<AActor>, TArray<FPrimitiveEntry>>& Pair : ActorPrimitives)
+	{
+		EntryCount += Pair.Value.Num();
+	}
+
+	NewSnapshot->Centers.Reserve(EntryCount);
+	NewSnapshot->Radii.Reserve(EntryCount);
+	NewSnapshot->Triangles.Reserve(EntryCount);
+
+	for (const TPair<TObjectKey<AActor>, TArray<FPrimitiveEntry>>& Pair : ActorPrimitives)
+	{
+		for (const FPrimitiveEntry& Entry : Pair.Value)
+		{
+			NewSnapshot->Centers.Add(Entry.Center);
+			NewSnapshot->Radii.Add(Entry.Radius);
+			NewSnapshot->Triangles.Add(Entry.Triangles);
+		}
+	}
+
+	Snapshot = NewSnapshot;
+	bHasRemovedActors = false;
+}
+
+void FBELightCostEstimator::GatherActor(const AActor* InActor)
+{
+	if (!IsValid(InActor)) { return; }
+
+	// The Bright Eye's own helper components are not part of what the light costs.
+	if (InActor->IsA<ABEBrightEyeActor>()) { return; }
+
+	TArray<FPrimitiveEntry>& Entries = ActorPrimitives.FindOrAdd(InActor);
+	Entries.Reset();
+
+	InActor->ForEachComponent<UPrimitiveComponent>(false, [&Entries](const UPrimitiveComponent* Primitive)
+	{
+		if (!IsValid(Primitive) || !Primitive->IsRegistered() || !Primitive->IsVisibleInEditor()) { return; }
+
+		int64 TriangleCount = 0;
+		if (const UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Primitive))
+		{
+			if (const UStaticMesh* StaticMesh = MeshComponent->GetStaticMesh())
+			{
+				TriangleCount = StaticMesh->GetNumTriangles(0);
+			}
+
+			if (const UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(MeshComponent))
+			{
+				TriangleCount *= InstancedComponent->GetInstanceCount();
+			}
+		}
+
+		FPrimitiveEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Center = Primitive->Bounds.Origin;
+		Entry.Radius = Primitive->Bounds.SphereRadius;
+		Entry.Triangles = TriangleCount;
+	});
+
+	if (Entries.Num() == 0)
+	{
+		ActorPrimitives.Remove(InActor);
+	}
+}
+
+bool FBELightCostEstimator::HasPoseChanged(const FQueryPose& InPose) const
+{
+	if (!bHasQueried) { return true; }
+
+	if (FVector::DistSquared(InPose.Location, LastQueryPose.Location) > FMath::Square(QueryMoveThreshold)) { return true; }
+
+	if ((InPose.Direction | LastQueryPose.Direction) < QueryAngleThresholdCos) { return true; }
+
+	if (!FMath::IsNearlyEqual(InPose.OuterConeAngle, LastQueryPose.OuterConeAngle, LastQueryPose.OuterConeAngle * QueryShapeThreshold)) { return true; }
+
+	if (!FMath::IsNearlyEqual(InPose.AttenuationRadius, LastQueryPose.AttenuationRadius, LastQueryPose.AttenuationRadius * QueryShapeThreshold)) { return true; }
+
+	return InPose.PrimitiveBudget != LastQueryPose.PrimitiveBudget;
+}
+
+FBELightCostResult FBELightCostEstimator::RunQuery(const FPrimitiveSnapshot& InSnapshot, const FQueryPose& InPose)
+{
+	FBELightCostResult QueryResult;
+	QueryResult.bIsValid = true;
+
+	const float HalfAngle = FMath::DegreesToRadians(FMath::Clamp(InPose.OuterConeAngle, 0.0f, 89.0f));
+	const float CosHalfAngle = FMath::Cos(HalfAngle);
+	const float SinHalfAngle = FMath::Sin(HalfAngle);
+
+	// Distance from the apex to the near side of every touched primitive and its triangles, used to find the radius that fits the budget.
+	// Primitives whose bounds enclose the apex are reached at any radius, so they are counted apart and never pick the cap.
+	TArray<TPair<float, int64>> Touches;
+	int32 EnclosingPrimitiveCount = 0;
+	int64 EnclosingTriangleCount = 0;
+
+	for (int32 Index = 0; Index < InSnapshot.Centers.Num(); ++Index)
+	{
+		const FVector ToCenter = InSnapshot.Centers[Index] - InPose.Location;
+		const float Radius = InSnapshot.Radii[Index];
+		const float DistanceSq = ToCenter.SizeSquared();
+
+		if (DistanceSq > FMath::Square(InPose.AttenuationRadius + Radius)) { continue; }
+
+		// Sphere against cone: distance from the sphere center to the cone surface.
+		const float Along = ToCenter | InPose.Direction;
+		const float Across = FMath::Sqrt(FMath::Max(DistanceSq - Along * Along, 0.0f));
+		const bool bInsideApex = DistanceSq <= Radius * Radius;
+		if (!bInsideApex && Across * CosHalfAngle - Along * SinHalfAngle > Radius) { continue; }
+
+		++QueryResult.PrimitiveCount;
+		QueryResult.TriangleCount += InSnapshot.Triangles[Index];
+
+		if (InPose.PrimitiveBudget <= 0) { continue; }
+
+		if (bInsideApex)
+		{
+			++EnclosingPrimitiveCount;
+			EnclosingTriangleCount += InSnapshot.Triangles[Index];
+		}
+		else
+		{
+			Touches.Emplace(FMath::Sqrt(DistanceSq) - Radius, InSnapshot.Triangles[Index]);
+		}
+	}
+
+	if (InPose.PrimitiveBudget > 0 && QueryResult.PrimitiveCount > InPose.PrimitiveBudget)
+	{
+		QueryResult.bIsCapped = true;
+		QueryResult.BudgetRadius = MinBudgetRadius;
+
+		Touches.Sort([](const TPair<float, int64>& A, const TPair<float, int64>& B) { return A.Key < B.Key; });
+
+		// Enclosing primitives use up their share of the budget first; when they alone exceed it, the cap stays at its minimum.
+		const int32 RemainingBudget = InPose.PrimitiveBudget - EnclosingPrimitiveCount;
+		if (RemainingBudget > 0)
+		{
+			QueryResult.BudgetRadius = FMath::Max(Touches[RemainingBudget - 1].Key, MinBudgetRadius);
+		}
+
+		// What the capped light actually reaches, so the panel reports the cost that is being paid.
+		QueryResult.CappedPrimitiveCount = EnclosingPrimitiveCount;
+		QueryResult.CappedTriangleCount = EnclosingTriangleCount;
+		for (const TPair<float, int64>& Touch : Touches)
+		{
+			if (Touch.Key > QueryResult.BudgetRadius) { break; }
+
+			++QueryResult.CappedPrimitiveCount;
+			QueryResult.CappedTriangleCount += Touch.Value;
+		}
+	}
+
+	return QueryResult;
+}
@@ -0,0 +1,96 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class USpotLightComponent;
+
+/**
+ * Result of one light cost query. bIsCapped is set only when the primitive budget was exceeded,
+ * in which case BudgetRadius is the radius that fits the budget and the capped counts cover the primitives that are still reached within it.
+ */
+struct FBELightCostResult
+{
+	int32 PrimitiveCount = 0;
+	int64 TriangleCount = 0;
+	bool bIsCapped = false;
+	float BudgetRadius = 0.0f;
+	int32 CappedPrimitiveCount = 0;
+	int64 CappedTriangleCount = 0;
+	bool bIsValid = false;
+};
+
+/**
+ * FBELightCostEstimator counts the primitives and triangles inside the Bright Eye's cone and attenuation sphere.
+ * Primitive bounds of the editor world are kept per actor and only regathered for actors reported as changed,
+ * and the cone queries run on the thread pool against an immutable snapshot of them,
+ * throttled so a new query only starts when the light pose, its shape or the scene changed meaningfully.
+ */
+class FBELightCostEstimator
+{
+	// Runs the cone query against hand built snapshots.
+	friend class FBELightCostCapTest;
+
+public:
+	// The cap never goes below this, so a light inside large bounds is not blacked out.
+	static constexpr float MinBudgetRadius = 100.0f;
+
+	// Returns true when a new result arrived this tick.
+	bool Tick(float InDeltaTime, UWorld* InWorld, const USpotLightComponent* InLight, float InAttenuationRadius, int32 InPrimitiveBudget);
+	void Reset();
+
+	void MarkActorDirty(const AActor* InActor);
+	void RemoveActor(const AActor* InActor);
+
+	bool HasSnapshot() const { return SnapshotWorld.IsValid(); }
+	const FBELightCostResult& GetResult() const { return Result; }
+
+private:
+	struct FPrimitiveEntry
+	{
+		FVector Center = FVector::ZeroVector;
+		float Radius = 0.0f;
+		int64 Triangles = 0;
+	};
+
+	struct FPrimitiveSnapshot
+	{
+		TArray<FVector> Centers;
+		TArray<float> Radii;
+		TArray<int64> Triangles;
+	};
+
+	struct FQueryPose
+	{
+		FVector Location = FVector::ZeroVector;
+		FVector Direction = FVector::ForwardVector;
+		float OuterConeAngle = 0.0f;
+		float AttenuationRadius = 0.0f;
+		int32 PrimitiveBudget = 0;
+	};
+
+	bool IsSceneDirty(const UWorld* InWorld) const;
+	void RefreshSnapshot(UWorld* InWorld);
+	void GatherActor(const AActor* InActor);
+	bool HasPoseChanged(const FQueryPose& InPose) const;
+	static FBELightCostResult RunQuery(const FPrimitiveSnapshot& InSnapshot, const FQueryPose& InPose);
+
+	TSharedPtr<const FPrimitiveSnapshot, ESPMode::ThreadSafe> Snapshot;
+	TWeakObjectPtr<UWorld> SnapshotWorld;
+
+	TMap<TObjectKey<AActor>, TArray<FPrimitiveEntry>> ActorPrimitives;
+	TSet<TWeakObjectPtr<const AActor>> DirtyActors;
+	bool bHasRemovedActors = false;
+
+	TFuture<FBELightCostResult> PendingQuery;
+	FQueryPose LastQueryPose;
+	bool bHasQueried = false;
+	float TimeSinceLastQuery = 0.0f;
+
+	FBELightCostResult Result;
+};
@@ -0,0 +1,140 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "LightOverlay.h"
+#include "GeometryUtils.h"
+#include "SceneView.h"
+#include "Components/SpotLightComponent.h"
+#include "Debug/DebugDrawService.h"
+#include "Engine/Canvas.h"
+#include "System/BrightEyeStats.h"
+
+constexpr int32 CircleSegments = 32;
+constexpr int32 ConeEdgeCount = 4;
+constexpr float HitMarkerSize = 6.0f;
+constexpr float LineThickness = 1.0f;
+
+static const FLinearColor ConeColor(1.0f, 0.85f, 0.3f, 0.9f);
+static const FLinearColor SphereColor(0.3f, 0.7f, 1.0f, 0.35f);
+static const FLinearColor HitColor(1.0f, 0.25f, 0.2f, 1.0f);
+
+FBELightOverlay::~FBELightOverlay()
+{
+	SetEnabled(false);
+}
+
+void FBELightOverlay::SetEnabled(const bool bInEnabled)
+{
+	if (bInEnabled == IsEnabled()) { return; }
+
+	if (bInEnabled)
+	{
+		DrawHandle = UDebugDrawService::Register(TEXT("Editor"), FDebugDrawDelegate::CreateRaw(this, &FBELightOverlay::Draw));
+		++FBrightEyeLiveCounts::OverlayDrawHandles;
+	}
+	else
+	{
+		UDebugDrawService::Unregister(DrawHandle);
+		DrawHandle.Reset();
+		--FBrightEyeLiveCounts::OverlayDrawHandles;
+	}
+}
+
+void FBELightOverlay::Draw(UCanvas* InCanvas, APlayerController* InPlayerController) const
+{
+	const USpotLightComponent* SpotLight = Light.Get();
+	if (!InCanvas || !InCanvas->SceneView || !IsValid(SpotLight) || !SpotLight->IsVisible()) { return; }
+
+	// Only views of the world the light lives in, so PIE and asset editor viewports stay clean.
+	const FSceneViewFamily* ViewFamily = InCanvas->SceneView->Family;
+	if (!ViewFamily || !ViewFamily->Scene || ViewFamily->Scene->GetWorld() != SpotLight->GetWorld()) { return; }
+
+	const FVector Apex = SpotLight->GetComponentLocation();
+	const FQuat Rotation = SpotLight->GetComponentQuat();
+	const FVector Forward = Rotation.GetForwardVector();
+	const FVector Right = Rotation.GetRightVector();
+	const FVector Up = Rotation.GetUpVector();
+
+	const float Range = SpotLight->AttenuationRadius;
+	const float HalfAngle = FMath::DegreesToRadians(FMath::Clamp(SpotLight->OuterConeAngle, 0.0f, 89.0f));
+
+	// Cone outline: the rim where the cone meets the attenuation sphere, and a few edges from the apex.
+	const float RimDistance = Range * FMath::Cos(HalfAngle);
+	const float RimRadius = Range * FMath::Sin(HalfAngle);
+	const FVector RimCenter = Apex + Forward * RimDistance;
+
+	DrawCircle(InCanvas, RimCenter, Right, Up, RimRadius, ConeColor);
+
+	for (int32 Edge = 0; Edge < ConeEdgeCount; ++Edge)
+	{
+		float Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, UE_TWO_PI * Edge / ConeEdgeCount);
+		DrawLine(InCanvas, Apex, RimCenter + (Right * Cos + Up * Sin) * RimRadius, ConeColor);
+	}
+
+	// Attenuation sphere as three great circles.
+	DrawCircle(InCanvas, Apex, Right, Up, Range, SphereColor);
+	DrawCircle(InCanvas, Apex, Forward, Right, Range, SphereColor);
+	DrawCircle(InCanvas, Apex, Forward, Up, Range, SphereColor);
+
+	FVector HitLocation;
+	if (FGeometryUtils::GetLastTraceHit(HitLocation))
+	{
+		const FVector ViewOrigin = InCanvas->SceneView->ViewMatrices.GetViewOrigin();
+		if (((HitLocation - ViewOrigin) | InCanvas->SceneView->GetViewDirection()) > 0.0f)
+		{
+			const FVector ScreenHit = InCanvas->Project(HitLocation);
+			const FVector2D Center(ScreenHit.X, ScreenHit.Y);
+
+			InCanvas->K2_DrawLine(Center - FVector2D(HitMarkerSize, HitMarkerSize), Center + FVector2D(HitMarkerSize, HitMarkerSize), 2.0f, HitColor);
+			InCanvas->K2_DrawLine(Center - FVector2D(HitMarkerSize, -HitMarkerSize), Center + FVector2D(HitMarkerSize, -HitMarkerSize), 2.0f, HitColor);
+		}
+
+		DrawLine(InCanvas, Apex, HitLocation, HitColor);
+	}
+}
+
+void FBELightOverlay::DrawCircle(UCanvas* InCanvas, const FVector& InCenter, const FVector& InAxisX, const FVector& InAxisY, const float InRadius, const FLinearColor& InColor) const
+{
+	FVector Previous = InCenter + InAxisX * InRadius;
+
+	for (int32 Segment = 1; Segment <= CircleSegments; ++Segment)
+	{
+		float Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, UE_TWO_PI * Segment / CircleSegments);
+
+		const FVector Current = InCenter + (InAxisX * Cos + InAxisY * Sin) * InRadius;
+		DrawLine(InCanvas, Previous, Current, InColor);
+		Previous = Current;
+	}
+}
+
+void FBELightOverlay::DrawLine(UCanvas* InCanvas, const FVector& InStart, const FVector& InEnd, const FLinearColor& InColor) const
+{
+	const FSceneView* View = InCanvas->SceneView;
+	const FVector ViewOrigin = View->ViewMatrices.GetViewOrigin();
+	const FVector ViewDirection = View->GetViewDirection();
+
+	// Segments are clipped to the near side of the camera, since projecting points behind it flips them across the screen.
+	const float NearDistance = GNearClippingPlane;
+	const float StartDepth = (InStart - ViewOrigin) | ViewDirection;
+	const float EndDepth = (InEnd - ViewOrigin) | ViewDirection;
+
+	if (StartDepth < NearDistance && EndDepth < NearDistance) { return; }
+
+	FVector Start = InStart;
+	FVector End = InEnd;
+	if (StartDepth < NearDistance)
+	{
+		Start = FMath::Lerp(InStart, InEnd, (NearDistance - StartDepth) / (EndDepth - StartDepth));
+	}
+	else if (EndDepth < NearDistance)
+	{
+		End = FMath::Lerp(InEnd, InStart, (NearDistance - EndDepth) / (StartDepth - EndDepth));
+	}
+
+	const FVector ScreenStart = InCanvas->Project(Start);
+	const FVector ScreenEnd = InCanvas->Project(End);
+
+	InCanvas->K2_DrawLine(FVector2D(ScreenStart.X, ScreenStart.Y), FVector2D(ScreenEnd.X, ScreenEnd.Y), LineThickness, InColor);
+}
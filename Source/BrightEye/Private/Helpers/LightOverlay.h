@@ -0,0 +1,35 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class APlayerController;
+class UCanvas;
+class USpotLightComponent;
+
+/**
+ * FBELightOverlay draws the Bright Eye's cone outline, attenuation sphere and trace hit point on the editor viewports' debug canvas.
+ * The draw callback is only registered while the overlay is shown, it reuses the hit found by the light traces,
+ * and all geometry is generated on the fly, so it neither traces nor allocates per frame.
+ */
+class FBELightOverlay
+{
+public:
+	~FBELightOverlay();
+
+	void SetEnabled(bool bInEnabled);
+	bool IsEnabled() const { return DrawHandle.IsValid(); }
+
+	void SetLight(USpotLightComponent* InLight) { Light = InLight; }
+
+private:
+	void Draw(UCanvas* InCanvas, APlayerController* InPlayerController) const;
+
+	void DrawCircle(UCanvas* InCanvas, const FVector& InCenter, const FVector& InAxisX, const FVector& InAxisY, float InRadius, const FLinearColor& InColor) const;
+	void DrawLine(UCanvas* InCanvas, const FVector& InStart, const FVector& InEnd, const FLinearColor& InColor) const;
+
+	TWeakObjectPtr<USpotLightComponent> Light;
+	FDelegateHandle DrawHandle;
+};
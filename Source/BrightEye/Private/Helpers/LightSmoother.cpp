@@ -0,0 +1,78 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "LightSmoother.h"
+
+constexpr float Ln2 = 0.69314718f;
+constexpr float MinHalfLife = 0.001f;
+constexpr float MaxPredictionTime = 0.05f;
+constexpr float TargetVelocitySmoothing = 0.5f;
+constexpr float SubstepTolerance = 1.0e-5f; // Absorbs float error so a 1/60 frame always runs exactly four substeps
+
+namespace BELightSmoother
+{
+	/** Rotation vector (axis * angle) of the shortest rotation represented by the quaternion. */
+	FVector ToShortestRotationVector(const FQuat& InQuat)
+	{
+		return (InQuat.W < 0.0f ? InQuat * -1.0f : InQuat).ToRotationVector();
+	}
+}
+
+void FBELightSmoother::Reset(const FQuat& InRotation)
+{
+	Rotation = InRotation.GetNormalized();
+	AngularVelocity = FVector::ZeroVector;
+	PreviousTarget = Rotation;
+	TargetAngularVelocity = FVector::ZeroVector;
+	bHasPreviousTarget = false;
+	Accumulator = 0.0f;
+}
+
+const FQuat& FBELightSmoother::Update(const FQuat& InTarget, const float InDeltaTime, const float InHalfLife, const bool bInPredict)
+{
+	// A hitch is simulated as a capped frame, so the light keeps easing instead of snapping to the target.
+	const float FrameTime = FMath::Clamp(InDeltaTime, 0.0f, MaxFrameTime);
+	const FQuat Target = InTarget.GetNormalized();
+
+	if (FrameTime > 0.0f && bHasPreviousTarget)
+	{
+		const FVector FrameVelocity = BELightSmoother::ToShortestRotationVector(Target * PreviousTarget.Inverse()) / FrameTime;
+		TargetAngularVelocity = FMath::Lerp(FrameVelocity, TargetAngularVelocity, TargetVelocitySmoothing);
+	}
+
+	PreviousTarget = Target;
+	bHasPreviousTarget = true;
+
+	// The target was sampled a frame ago, so it is pushed forward by that frame's latency.
+	FQuat Goal = Target;
+	if (bInPredict)
+	{
+		Goal = (FQuat::MakeFromRotationVector(TargetAngularVelocity * FMath::Min(FrameTime, MaxPredictionTime)) * Target).GetNormalized();
+	}
+
+	Accumulator += FrameTime;
+
+	const float StrideTime = FixedSubstep * SubstepStride;
+	while (Accumulator + SubstepTolerance >= StrideTime)
+	{
+		Step(Goal, StrideTime, InHalfLife);
+		Accumulator -= StrideTime;
+	}
+
+	return Rotation;
+}
+
+void FBELightSmoother::Step(const FQuat& InGoal, const float InStepTime, const float InHalfLife)
+{
+	// Exact critically damped spring step, written in the goal's tangent space.
+	const float Damping = 2.0f * Ln2 / FMath::Max(InHalfLife, MinHalfLife);
+	const float Decay = FMath::Exp(-Damping * InStepTime);
+
+	const FVector Offset = BELightSmoother::ToShortestRotationVector(Rotation * InGoal.Inverse());
+	const FVector Drift = AngularVelocity + Offset * Damping;
+
+	const FVector NewOffset = (Offset + Drift * InStepTime) * Decay;
+	AngularVelocity = (AngularVelocity - Drift * (Damping * InStepTime)) * Decay;
+
+	Rotation = (FQuat::MakeFromRotationVector(NewOffset) * InGoal).GetNormalized();
+}
@@ -0,0 +1,41 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FBELightSmoother follows a target rotation with a critically damped spring integrated at a fixed substep.
+ * Frame time only decides how many substeps run, so the same input trace always produces the same rotations,
+ * and the perceived lag does not change with the editor frame rate or collapse after a hitch.
+ */
+class FBELightSmoother
+{
+public:
+	void Reset(const FQuat& InRotation);
+
+	// Advances the spring towards the target. When prediction is on, the target is extrapolated by its own angular velocity over the frame time.
+	const FQuat& Update(const FQuat& InTarget, float InDeltaTime, float InHalfLife, bool bInPredict);
+
+	// Lets callers trade smoothing accuracy for time. A stride of N integrates N fixed substeps at once.
+	void SetSubstepStride(int32 InStride) { SubstepStride = FMath::Max(InStride, 1); }
+
+	const FQuat& GetRotation() const { return Rotation; }
+
+	static constexpr float FixedSubstep = 1.0f / 240.0f;
+	static constexpr float MaxFrameTime = 0.1f;
+
+private:
+	void Step(const FQuat& InGoal, float InStepTime, float InHalfLife);
+
+	FQuat Rotation = FQuat::Identity;
+	FVector AngularVelocity = FVector::ZeroVector;
+
+	FQuat PreviousTarget = FQuat::Identity;
+	FVector TargetAngularVelocity = FVector::ZeroVector;
+	bool bHasPreviousTarget = false;
+
+	float Accumulator = 0.0f;
+	int32 SubstepStride = 1;
+};
@@ -0,0 +1,31 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("BrightEye"), STATGROUP_BrightEye, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick"), STAT_BrightEyeTick, STATGROUP_BrightEye, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Tick Cost (ms)"), STAT_BrightEyeTickCost, STATGROUP_BrightEye, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Degradation Level"), STAT_BrightEyeDegradationLevel, STATGROUP_BrightEye, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Trace Flush"), STAT_BrightEyeTraceFlush, STATGROUP_BrightEye, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces Submitted"), STAT_BrightEyeTracesSubmitted, STATGROUP_BrightEye, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces Executed"), STAT_BrightEyeTracesExecuted, STATGROUP_BrightEye, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Panels"), STAT_BrightEyeLivePanels, STATGROUP_BrightEye, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Helper Actors"), STAT_BrightEyeLiveHelperActors, STATGROUP_BrightEye, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Fade Tickers"), STAT_BrightEyeFadeTickers, STATGROUP_BrightEye, );
+
+/**
+ * The live accumulators mirrored as plain counters, along with the manager's core ticker, overlay draw and scene delegate registrations,
+ * so the lifecycle tests can read them even when stats are compiled out.
+ */
+struct FBrightEyeLiveCounts
+{
+	static int32 Panels;
+	static int32 FadeTickers;
+	static int32 CoreTickers;
+	static int32 OverlayDrawHandles;
+	static int32 SceneDelegateBindings;
+};
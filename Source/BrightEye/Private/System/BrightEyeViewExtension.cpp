@@ -0,0 +1,51 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "BrightEyeViewExtension.h"
+#include "Components/SceneComponent.h"
+#include "Helpers/GeometryUtils.h"
+#include "Misc/App.h"
+#include "SceneView.h"
+
+FBEViewExtension::FBEViewExtension(const FAutoRegister& AutoRegister)
+	: FSceneViewExtensionBase(AutoRegister)
+{
+}
+
+bool FBEViewExtension::CanExtendViews()
+{
+	return GEngine && GEngine->ViewExtensions && FApp::CanEverRender() && !GUsingNullRHI;
+}
+
+void FBEViewExtension::SetFollowTarget(USceneComponent* InLight, FViewport* InViewport, const FVector2D& InViewOffset)
+{
+	FollowLight = InLight;
+	FollowViewport = InViewport;
+	ViewOffset = InViewOffset;
+}
+
+void FBEViewExtension::ClearFollowTarget()
+{
+	FollowLight.Reset();
+	FollowViewport = nullptr;
+}
+
+bool FBEViewExtension::IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const
+{
+	return IsFollowing() && Context.Viewport == FollowViewport;
+}
+
+void FBEViewExtension::SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView)
+{
+	USceneComponent* Light = FollowLight.Get();
+	if(!IsValid(Light)){return;}
+
+	const FVector ViewLocation = InView.ViewMatrices.GetViewOrigin();
+	const FRotator ViewRotation = InView.ViewRotation;
+
+	const FVector LightLocation = FGeometryUtils::GetLightLocationFromView(ViewLocation, ViewRotation, ViewOffset);
+	const FRotator LightRotation = ViewOffset.IsZero() ? ViewRotation : FGeometryUtils::AdjustLightRotationFromTrace(ViewLocation, ViewRotation, LightLocation);
+
+	// The move is picked up by the end of frame update that runs right before this view family is rendered.
+	Light->SetWorldLocationAndRotation(LightLocation, LightRotation);
+}
@@ -0,0 +1,45 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SceneViewExtension.h"
+
+class USceneComponent;
+class FViewport;
+
+/**
+ * FBEViewExtension moves the Bright Eye light from inside the followed viewport's view setup.
+ * The pose is computed from the final view of the frame being rendered, right before render proxies are flushed,
+ * so the light never trails the camera and nothing has to run on the editor tick while the camera is still.
+ */
+class FBEViewExtension : public FSceneViewExtensionBase
+{
+public:
+	FBEViewExtension(const FAutoRegister& AutoRegister);
+
+	// Returns false when views cannot be extended in this session, for example under -nullrhi.
+	static bool CanExtendViews();
+
+	void SetFollowTarget(USceneComponent* InLight, FViewport* InViewport, const FVector2D& InViewOffset);
+	void ClearFollowTarget();
+	bool IsFollowing() const { return FollowLight.IsValid() && FollowViewport != nullptr; }
+	bool IsFollowing(const USceneComponent* InLight, const FViewport* InViewport, const FVector2D& InViewOffset) const
+	{
+		return IsFollowing() && FollowLight.Get() == InLight && FollowViewport == InViewport && ViewOffset == InViewOffset;
+	}
+
+	// ISceneViewExtension
+	virtual void SetupViewFamily(FSceneViewFamily& InViewFamily) override {}
+	virtual void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override;
+	virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override {}
+
+protected:
+	virtual bool IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const override;
+
+private:
+	TWeakObjectPtr<USceneComponent> FollowLight;
+	FViewport* FollowViewport = nullptr;
+	FVector2D ViewOffset = FVector2D::ZeroVector;
+};
@@ -47,4 +47,107 @@ void FBECommands::RegisterCommands()
 			EUserInterfaceActionType::Button,
 			FInputChord(EKeys::T, EModifierKey::Control));
 	}
+	{
+		const FText Label = FText::FromString(TEXT("Stamp Bright Eye"));
+		const FText Desc = FText::FromString(TEXT("Leaves a transient copy of the current BrightEye light at the camera."));
+
+		FUICommandInfo::MakeCommandInfo(
+			this->AsShared(),
+			StampBrightEye,
+			"StampBrightEye",
+			Label,
+			Desc,
+			FSlateIcon(),
+			EUserInterfaceActionType::Button,
+			FInputChord(EKeys::T, EModifierKey::Shift));
+	}
+	{
+		const FText Label = FText::FromString(TEXT("Clear Light Stamps"));
+		const FText Desc = FText::FromString(TEXT("Removes every BrightEye light stamp."));
+
+		FUICommandInfo::MakeCommandInfo(
+			this->AsShared(),
+			ClearLightStamps,
+			"ClearBrightEyeLightStamps",
+			Label,
+			Desc,
+			FSlateIcon(),
+			EUserInterfaceActionType::Button,
+			FInputChord());
+	}
+	{
+		const FText Label = FText::FromString(TEXT("Convert Light Stamps"));
+		const FText Desc = FText::FromString(TEXT("Replaces every BrightEye light stamp with a spot light actor in the level."));
+
+		FUICommandInfo::MakeCommandInfo(
+			this->AsShared(),
+			ConvertLightStamps,
+			"ConvertBrightEyeLightStamps",
+			Label,
+			Desc,
+			FSlateIcon(),
+			EUserInterfaceActionType::Button,
+			FInputChord());
+	}
+	{
+		const FText Label = FText::FromString(TEXT("Toggle Dark Spots"));
+		const FText Desc = FText::FromString(TEXT("Estimates direct lighting around the view and highlights under-lit regions."));
+
+		FUICommandInfo::MakeCommandInfo(
+			this->AsShared(),
+			ToggleDarkSpots,
+			"ToggleBrightEyeDarkSpots",
+			Label,
+			Desc,
+			FSlateIcon(),
+			EUserInterfaceActionType::Button,
+			FInputChord(EKeys::B, EModifierKey::Control | EModifierKey::Shift));
+	}
+	{
+		const FText Label = FText::FromString(TEXT("Aim At Darkest Spot"));
+		const FText Desc = FText::FromString(TEXT("Points the BrightEye at the darkest visible dark spot cell. Aim again to release it."));
+
+		FUICommandInfo::MakeCommandInfo(
+			this->AsShared(),
+			AimAtDarkestSpot,
+			"AimBrightEyeAtDarkestSpot",
+			Label,
+			Desc,
+			FSlateIcon(),
+			EUserInterfaceActionType::Button,
+			FInputChord(EKeys::F, EModifierKey::Control | EModifierKey::Shift));
+	}
+	{
+		const FText Label = FText::FromString(TEXT("Toggle Light Overlay"));
+		const FText Desc = FText::FromString(TEXT("Draws the BrightEye cone, reach and hit point over the viewport."));
+
+		FUICommandInfo::MakeCommandInfo(
+			this->AsShared(),
+			ToggleLightOverlay,
+			"ToggleBrightEyeLightOverlay",
+			Label,
+			Desc,
+			FSlateIcon(),
+			EUserInterfaceActionType::Button,
+			FInputChord(EKeys::O, EModifierKey::Control | EModifierKey::Shift));
+	}
+
+	const FKey PresetKeys[NumPresetCommands] = { EKeys::One, EKeys::Two, EKeys::Three, EKeys::Four, EKeys::Five, EKeys::Six, EKeys::Seven, EKeys::Eight, EKeys::Nine };
+
+	ApplyPresetCommands.SetNum(NumPresetCommands);
+	for (int32 Index = 0; Index < NumPresetCommands; ++Index)
+	{
+		const FText Label = FText::FromString(FString::Printf(TEXT("Apply Bright Eye Preset %d"), Index + 1));
+		const FText Desc = FText::FromString(FString::Printf(TEXT("Switches the BrightEye to light preset %d."), Index + 1));
+
+		FUICommandInfo::MakeCommandInfo(
+			this->AsShared(),
+			ApplyPresetCommands[Index],
+			FName(*FString::Printf(TEXT("ApplyBrightEyePreset%d"), Index + 1)),
+			Label,
+			Desc,
+			FSlateIcon(),
+			EUserInterfaceActionType::Button,
+			FInputChord(PresetKeys[Index], EModifierKey::Control | EModifierKey::Shift));
+	}
 }
\ No newline at end of file
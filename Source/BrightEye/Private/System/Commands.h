@@ -24,4 +24,13 @@ public:
 	TSharedPtr<FUICommandInfo> ToggleBrightEye;
 	TSharedPtr<FUICommandInfo> ToggleControlPanel;
 	TSharedPtr<FUICommandInfo> AimBrightEye;
+	TSharedPtr<FUICommandInfo> StampBrightEye;
+	TSharedPtr<FUICommandInfo> ClearLightStamps;
+	TSharedPtr<FUICommandInfo> ConvertLightStamps;
+	TSharedPtr<FUICommandInfo> ToggleDarkSpots;
+	TSharedPtr<FUICommandInfo> AimAtDarkestSpot;
+	TSharedPtr<FUICommandInfo> ToggleLightOverlay;
+
+	static constexpr int32 NumPresetCommands = 9;
+	TArray<TSharedPtr<FUICommandInfo>> ApplyPresetCommands;
 };
\ No newline at end of file
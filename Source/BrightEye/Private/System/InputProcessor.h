@@ -51,7 +51,14 @@ public:
 
     virtual bool HandleMouseWheelOrGestureEvent(FSlateApplication& SlateApp, const FPointerEvent& InWheelEvent, const FPointerEvent* InGestureEvent) override
     {
-        if (InWheelEvent.GetWheelDelta() != 0)
+        const float Notches = GetWheelNotches(InWheelEvent, InGestureEvent);
+        if (Notches != 0 && OnParamWheel.IsBound() && OnParamWheel.Execute(InWheelEvent.GetModifierKeys(), Notches))
+        {
+            return true;
+        }
+
+        // Trackpad gestures arrive many times per frame, so they are never turned into command lookups.
+        if (InGestureEvent == nullptr && InWheelEvent.GetWheelDelta() != 0)
         {
             const FKey Key = InWheelEvent.GetWheelDelta() < 0 ? EKeys::MouseScrollDown : EKeys::MouseScrollUp;
             const FModifierKeysState ModifierKeysState = InWheelEvent.GetModifierKeys();
@@ -66,6 +73,10 @@ public:
     FSettingsPressAnyKeyInputPreProcessorKeySelected OnKeySelected;
     FSettingsPressAnyKeyInputPreProcessorKeySelected OnKeReleased;
 
+    // Receives wheel and trackpad motion in wheel notches. Returning true consumes the event.
+    DECLARE_DELEGATE_RetVal_TwoParams(bool, FBEParamWheelSignature, const FModifierKeysState&, float /* Notches */);
+    FBEParamWheelSignature OnParamWheel;
+
 private:
     bool HandleKey(const FKeyEvent& KeyEvent, const bool bIsPressed) const
     {
@@ -77,6 +88,26 @@ private:
         return OnKeReleased.Execute(KeyEvent);
     }
 
+    static float GetWheelNotches(const FPointerEvent& InWheelEvent, const FPointerEvent* InGestureEvent)
+    {
+        static constexpr float ScrollPixelsPerNotch = 24.0f;
+        static constexpr float MagnifyPerNotch = 0.05f;
+
+        if (InGestureEvent != nullptr)
+        {
+            if (InGestureEvent->GetGestureType() == EGestureEvent::Scroll)
+            {
+                return InGestureEvent->GetGestureDelta().Y / ScrollPixelsPerNotch;
+            }
+            if (InGestureEvent->GetGestureType() == EGestureEvent::Magnify)
+            {
+                return InGestureEvent->GetGestureDelta().X / MagnifyPerNotch;
+            }
+        }
+
+        return InWheelEvent.GetWheelDelta();
+    }
+
     static FKeyEvent CreateKeyEventFromPointerEvent(const FPointerEvent& MouseEvent, bool bIsPressed)
     {
         const FModifierKeysState ModifierKeysState = MouseEvent.GetModifierKeys();
@@ -0,0 +1,329 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "Misc/AutomationTest.h"
+#include "BrightEyeManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "RenderingThread.h"
+#include "Data/BrightEyeActor.h"
+#include "System/BrightEyeStats.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "UI/BrightEyePanel.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectIterator.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static TAutoConsoleVariable<int32> CVarBrightEyeSoakCycles(
+	TEXT("BrightEye.SoakCycles"),
+	0,
+	TEXT("Overrides the cycle count of every BrightEye.Soak.Lifecycle variant when above zero."));
+
+namespace BrightEyeSoakTest
+{
+	constexpr float FrameTime = 1.0f / 60.0f;
+	constexpr int32 FramesPerStep = 3;
+	constexpr int32 DarkSpotInterval = 5;
+	constexpr int32 MapSwitchInterval = 12;
+	constexpr int32 MaxDarkSpotFrames = 600;
+
+	// Fixed allowances for editor noise from other systems. They do not scale with the cycle count,
+	// so anything left behind once per cycle exceeds them well within a long run.
+	constexpr int32 MaxLiveObjectGrowth = 32;
+	constexpr int64 MaxAllocationGrowth = 2048;
+
+	/** Forwards to the engine allocator and keeps the number of allocations that are still live. */
+	class FAllocationCounter final : public FMalloc
+	{
+	public:
+		void Install()
+		{
+			check(GMalloc != this);
+			Inner = GMalloc;
+			LiveAllocations = 0;
+			GMalloc = this;
+		}
+
+		void Uninstall()
+		{
+			check(GMalloc == this);
+			GMalloc = Inner;
+		}
+
+		int64 GetLiveAllocations() const { return LiveAllocations.load(); }
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			void* Result = Inner->Malloc(Count, Alignment);
+			if (Result) { ++LiveAllocations; }
+			return Result;
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			void* Result = Inner->TryMalloc(Count, Alignment);
+			if (Result) { ++LiveAllocations; }
+			return Result;
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			void* Result = Inner->Realloc(Original, Count, Alignment);
+			CountRealloc(Original, Count, Result);
+			return Result;
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			void* Result = Inner->TryRealloc(Original, Count, Alignment);
+			CountRealloc(Original, Count, Result);
+			return Result;
+		}
+
+		virtual void Free(void* Original) override
+		{
+			if (Original) { --LiveAllocations; }
+			Inner->Free(Original);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+	private:
+		void CountRealloc(const void* InOriginal, const SIZE_T InCount, const void* InResult)
+		{
+			if (!InOriginal && InResult) { ++LiveAllocations; }
+			else if (InOriginal && InCount == 0) { --LiveAllocations; }
+		}
+
+		FMalloc* Inner = nullptr;
+		std::atomic<int64> LiveAllocations = 0;
+	};
+
+	// Never destroyed, since another thread can still be inside it right after GMalloc is handed back.
+	FAllocationCounter& GetAllocationCounter()
+	{
+		static FAllocationCounter* Counter = new FAllocationCounter();
+		return *Counter;
+	}
+
+	struct FLifecycleSnapshot
+	{
+		int32 HelperActors = 0;
+		int32 Panels = 0;
+		int32 FadeTickers = 0;
+		int32 CoreTickers = 0;
+		int32 OverlayDrawHandles = 0;
+		int32 SceneDelegateBindings = 0;
+		int32 LiveObjects = 0;
+		int64 LiveAllocations = 0;
+	};
+
+	int32 CountHelperActors()
+	{
+		int32 Count = 0;
+		for (TObjectIterator<ABEBrightEyeActor> It; It; ++It)
+		{
+			if (!It->IsTemplate())
+			{
+				++Count;
+			}
+		}
+		return Count;
+	}
+
+	FLifecycleSnapshot TakeSnapshot()
+	{
+		// Destroyed actors stay in the object array until they are collected, and released render resources until the commands ran.
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		FlushRenderingCommands();
+
+		FLifecycleSnapshot Snapshot;
+		Snapshot.HelperActors = CountHelperActors();
+		Snapshot.Panels = FBrightEyeLiveCounts::Panels;
+		Snapshot.FadeTickers = FBrightEyeLiveCounts::FadeTickers;
+		Snapshot.CoreTickers = FBrightEyeLiveCounts::CoreTickers;
+		Snapshot.OverlayDrawHandles = FBrightEyeLiveCounts::OverlayDrawHandles;
+		Snapshot.SceneDelegateBindings = FBrightEyeLiveCounts::SceneDelegateBindings;
+		Snapshot.LiveObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+		Snapshot.LiveAllocations = GetAllocationCounter().GetLiveAllocations();
+		return Snapshot;
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FBrightEyeLifecycleSoakTest, "BrightEye.Soak.Lifecycle",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::StressFilter)
+
+void FBrightEyeLifecycleSoakTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	OutBeautifiedNames.Add(TEXT("Short"));
+	OutTestCommands.Add(TEXT("100"));
+
+	OutBeautifiedNames.Add(TEXT("Long"));
+	OutTestCommands.Add(TEXT("10000"));
+
+	OutBeautifiedNames.Add(TEXT("Soak"));
+	OutTestCommands.Add(TEXT("50000"));
+}
+
+bool FBrightEyeLifecycleSoakTest::RunTest(const FString& Parameters)
+{
+	using namespace BrightEyeSoakTest;
+
+	const TSharedPtr<FBrightEyeManagerImp> Manager = FBrightEyeManager::BrightEyeManagerImp;
+	if (!Manager.IsValid())
+	{
+		AddError(TEXT("The Bright Eye manager is not running."));
+		return false;
+	}
+
+	const int32 CycleOverride = CVarBrightEyeSoakCycles.GetValueOnGameThread();
+	const int32 Cycles = CycleOverride > 0 ? CycleOverride : FMath::Max(FCString::Atoi(*Parameters), 1);
+
+	if (!Manager->ActiveViewport.IsValid())
+	{
+		AddWarning(TEXT("No level viewport is active, so the panel and dark spot steps are skipped."));
+	}
+
+	auto TickFrames = [&Manager](const int32 InFrames)
+	{
+		for (int32 Frame = 0; Frame < InFrames; ++Frame)
+		{
+			Manager->OnTick(FrameTime);
+		}
+	};
+
+	auto ReleaseAll = [&Manager]()
+	{
+		Manager->ClearDarkSpots();
+		Manager->DestroyBrightEyePanel();
+		Manager->DestroyBrightLight();
+	};
+
+	auto RunIteration = [&Manager, &TickFrames](const int32 InIteration)
+	{
+		// Toggle
+		if (!IsValid(Manager->BrightEyeActor))
+		{
+			Manager->CreateBrightEyeLight();
+		}
+		Manager->SetLightVisibility(true);
+		TickFrames(FramesPerStep);
+		Manager->SetLightVisibility(false);
+
+		// Aim
+		Manager->PinnedAimLocation = FVector(100.0f * (InIteration % 10), 0.0f, 0.0f);
+		Manager->SetLightVisibility(true);
+		TickFrames(FramesPerStep);
+		Manager->PinnedAimLocation.Reset();
+		Manager->SetLightVisibility(false);
+
+		if (InIteration % DarkSpotInterval == 0 && Manager->BuildDarkSpots())
+		{
+			for (int32 Frame = 0; Frame < MaxDarkSpotFrames && !Manager->DarkSpotFinder.IsReady(); ++Frame)
+			{
+				TickFrames(1);
+				FPlatformProcess::Sleep(0.001f);
+			}
+
+			Manager->AimAtDarkestSpot();
+			TickFrames(FramesPerStep);
+			Manager->ClearDarkSpots();
+		}
+
+		// Panel show, hover and hide
+		if (!Manager->BrightEyePanelParent.IsValid())
+		{
+			Manager->CreateBrightEyePanel();
+		}
+		Manager->TryRevealBrightEyePanel();
+
+		if (Manager->BrightEyePanel.IsValid())
+		{
+			Manager->BrightEyePanel->ChangeHidePanelWhenIdle(true);
+
+			const TSharedRef<SWidget> PanelWidget = Manager->BrightEyePanel.ToSharedRef();
+			PanelWidget->OnMouseEnter(FGeometry(), FPointerEvent());
+			PanelWidget->OnMouseLeave(FPointerEvent());
+		}
+
+		TickFrames(FramesPerStep);
+		Manager->TryHideBrightEyePanel();
+
+		// Odd iterations tear everything down, so creation is churned as much as reuse.
+		if (InIteration % 2 == 1)
+		{
+			Manager->DestroyBrightEyePanel();
+			Manager->DestroyBrightLight();
+		}
+	};
+
+	// One cycle reuses the light and the panel once and then tears them down, so every cycle ends in the same state.
+	auto RunCycle = [&RunIteration](const int32 InCycle)
+	{
+		RunIteration(2 * InCycle);
+		RunIteration(2 * InCycle + 1);
+
+		// The map switch itself has to release what is left, so nothing is released by hand here.
+		if (InCycle % MapSwitchInterval == 0)
+		{
+			FAutomationEditorCommonUtils::CreateNewMap();
+		}
+	};
+
+	FAllocationCounter& AllocationCounter = GetAllocationCounter();
+	AllocationCounter.Install();
+
+	// Two warm-up cycles, the first ending in a map switch, so caches that are filled once are part of the baseline.
+	RunCycle(0);
+	RunCycle(1);
+	const FLifecycleSnapshot Baseline = TakeSnapshot();
+
+	for (int32 Cycle = 2; Cycle < Cycles + 2; ++Cycle)
+	{
+		RunCycle(Cycle);
+
+		const FLifecycleSnapshot Current = TakeSnapshot();
+		const int32 CycleNumber = Cycle - 1;
+
+		// The registrations are exact: the core ticker never changes, and the overlay and scene delegates are bound at most once, matching the manager's state.
+		bool bIsFlat = true;
+		bIsFlat &= TestEqual(*FString::Printf(TEXT("Bright Eye actors after cycle %d"), CycleNumber), Current.HelperActors, Baseline.HelperActors);
+		bIsFlat &= TestEqual(*FString::Printf(TEXT("Live panels after cycle %d"), CycleNumber), Current.Panels, Baseline.Panels);
+		bIsFlat &= TestEqual(*FString::Printf(TEXT("Fade tickers after cycle %d"), CycleNumber), Current.FadeTickers, Baseline.FadeTickers);
+		bIsFlat &= TestEqual(*FString::Printf(TEXT("Core tickers after cycle %d"), CycleNumber), Current.CoreTickers, Baseline.CoreTickers);
+		bIsFlat &= TestEqual(*FString::Printf(TEXT("Overlay draw handles after cycle %d"), CycleNumber),
+			Current.OverlayDrawHandles, Manager->LightOverlay.IsEnabled() ? 1 : 0);
+		bIsFlat &= TestEqual(*FString::Printf(TEXT("Scene delegate bindings after cycle %d"), CycleNumber),
+			Current.SceneDelegateBindings, Manager->bAreSceneDelegatesBound ? 1 : 0);
+		bIsFlat &= TestTrue(*FString::Printf(TEXT("Live UObjects grew by %d after cycle %d"), Current.LiveObjects - Baseline.LiveObjects, CycleNumber),
+			Current.LiveObjects - Baseline.LiveObjects <= MaxLiveObjectGrowth);
+		bIsFlat &= TestTrue(*FString::Printf(TEXT("Live allocations grew by %lld after cycle %d"), Current.LiveAllocations - Baseline.LiveAllocations, CycleNumber),
+			Current.LiveAllocations - Baseline.LiveAllocations <= MaxAllocationGrowth);
+
+		// The first cycle that grows is the one worth looking at; the rest would only repeat it.
+		if (!bIsFlat)
+		{
+			AddError(FString::Printf(TEXT("Lifecycle growth after cycle %d of %d."), CycleNumber, Cycles));
+			break;
+		}
+	}
+
+	ReleaseAll();
+	AllocationCounter.Uninstall();
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,72 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "Misc/AutomationTest.h"
+#include "Helpers/LightCostEstimator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace BELightCostEstimatorTest
+{
+	constexpr int32 EnclosingCount = 4;
+	constexpr int64 EnclosingTriangles = 100;
+	constexpr int64 OuterTriangles = 10;
+	constexpr float OuterRadius = 10.0f;
+	const float OuterDistances[] = { 1000.0f, 2000.0f, 3000.0f, 4000.0f };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBELightCostCapTest, "BrightEye.LightCost.CapInsideBounds",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBELightCostCapTest::RunTest(const FString& Parameters)
+{
+	using namespace BELightCostEstimatorTest;
+
+	// The light sits at the origin inside a few overlapping room sized bounds, with small props further down the cone.
+	FBELightCostEstimator::FPrimitiveSnapshot Snapshot;
+	for (int32 Index = 0; Index < EnclosingCount; ++Index)
+	{
+		Snapshot.Centers.Add(FVector(Index % 2 ? 50.0f : -50.0f, Index / 2 ? 50.0f : -50.0f, 0.0f));
+		Snapshot.Radii.Add(500.0f);
+		Snapshot.Triangles.Add(EnclosingTriangles);
+	}
+	for (const float Distance : OuterDistances)
+	{
+		Snapshot.Centers.Add(FVector(Distance, 0.0f, 0.0f));
+		Snapshot.Radii.Add(OuterRadius);
+		Snapshot.Triangles.Add(OuterTriangles);
+	}
+
+	FBELightCostEstimator::FQueryPose Pose;
+	Pose.Direction = FVector::ForwardVector;
+	Pose.OuterConeAngle = 30.0f;
+	Pose.AttenuationRadius = 5000.0f;
+
+	const int32 TotalCount = Snapshot.Centers.Num();
+
+	// Budget below the enclosing bounds alone: the cap stays at its minimum instead of dropping to zero.
+	Pose.PrimitiveBudget = EnclosingCount / 2;
+	FBELightCostResult Result = FBELightCostEstimator::RunQuery(Snapshot, Pose);
+	TestEqual(TEXT("All primitives are counted"), Result.PrimitiveCount, TotalCount);
+	TestTrue(TEXT("A budget smaller than the enclosing bounds caps the light"), Result.bIsCapped);
+	TestEqual(TEXT("The cap is held at its minimum radius"), Result.BudgetRadius, FBELightCostEstimator::MinBudgetRadius);
+	TestEqual(TEXT("Only the enclosing bounds are reached at the minimum radius"), Result.CappedPrimitiveCount, EnclosingCount);
+	TestEqual(TEXT("Capped triangles at the minimum radius"), Result.CappedTriangleCount, EnclosingCount * EnclosingTriangles);
+
+	// The enclosing bounds use their share first and the rest of the budget picks the cap among the props.
+	Pose.PrimitiveBudget = EnclosingCount + 2;
+	Result = FBELightCostEstimator::RunQuery(Snapshot, Pose);
+	TestTrue(TEXT("A budget between the enclosing and total counts caps the light"), Result.bIsCapped);
+	TestEqual(TEXT("The cap reaches the near side of the second prop"), Result.BudgetRadius, OuterDistances[1] - OuterRadius, 0.01f);
+	TestEqual(TEXT("Capped primitives"), Result.CappedPrimitiveCount, EnclosingCount + 2);
+	TestEqual(TEXT("Capped triangles"), Result.CappedTriangleCount, EnclosingCount * EnclosingTriangles + 2 * OuterTriangles);
+
+	// A budget that covers everything leaves the light uncapped.
+	Pose.PrimitiveBudget = TotalCount;
+	Result = FBELightCostEstimator::RunQuery(Snapshot, Pose);
+	TestFalse(TEXT("A budget covering every primitive does not cap the light"), Result.bIsCapped);
+
+	return true;
+}
+
+#endif
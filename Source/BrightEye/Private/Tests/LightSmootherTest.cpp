@@ -0,0 +1,159 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "Misc/AutomationTest.h"
+#include "Helpers/LightSmoother.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace BELightSmootherTest
+{
+	// The trace is authored in fixed substeps so every tested frame rate samples exactly the same targets.
+	constexpr int32 SubstepsPerSecond = 240;
+	constexpr int32 TraceTicks = 480;
+	constexpr int32 CheckpointTicks = 12;
+	constexpr float HalfLife = 0.08f;
+	constexpr float LagToleranceDegrees = 0.1f;
+	constexpr float SettleToleranceDegrees = 0.01f;
+
+	struct FTraceKey
+	{
+		int32 Tick;
+		FRotator Rotation;
+	};
+
+	const FTraceKey TraceKeys[] =
+	{
+		{ 0, FRotator(0.0f, 0.0f, 0.0f) },
+		{ 24, FRotator(-10.0f, 45.0f, 0.0f) },
+		{ 48, FRotator(-20.0f, 90.0f, 0.0f) },
+		{ 72, FRotator(-5.0f, 30.0f, 0.0f) },
+		{ 96, FRotator(0.0f, 120.0f, 0.0f) }
+	};
+
+	FQuat SampleTrace(const int32 InTick)
+	{
+		FRotator Rotation = TraceKeys[0].Rotation;
+		for (const FTraceKey& Key : TraceKeys)
+		{
+			if (Key.Tick > InTick){break;}
+			Rotation = Key.Rotation;
+		}
+		return Rotation.Quaternion();
+	}
+
+	float AngleDegrees(const FQuat& InA, const FQuat& InB)
+	{
+		return FMath::RadiansToDegrees(static_cast<float>(InA.AngularDistance(InB)));
+	}
+
+	struct FTraceRun
+	{
+		// Distance to the target at every checkpoint, which is how far the light lags behind the trace.
+		TArray<float> Lag;
+		FQuat SettledRotation = FQuat::Identity;
+	};
+
+	FTraceRun RunTrace(const int32 InFramesPerSecond, const bool bInPredict)
+	{
+		const int32 TicksPerFrame = SubstepsPerSecond / InFramesPerSecond;
+		const float DeltaTime = 1.0f / InFramesPerSecond;
+
+		FBELightSmoother Smoother;
+		Smoother.Reset(SampleTrace(0));
+
+		FTraceRun Run;
+		for (int32 Tick = 0; Tick < TraceTicks; Tick += TicksPerFrame)
+		{
+			const FQuat Target = SampleTrace(Tick);
+			const FQuat& Rotation = Smoother.Update(Target, DeltaTime, HalfLife, bInPredict);
+
+			if ((Tick + TicksPerFrame) % CheckpointTicks == 0)
+			{
+				Run.Lag.Add(AngleDegrees(Rotation, Target));
+			}
+		}
+
+		Run.SettledRotation = Smoother.GetRotation();
+		return Run;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBELightSmootherFrameRateTest, "BrightEye.LightSmoother.FrameRateIndependence",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBELightSmootherFrameRateTest::RunTest(const FString& Parameters)
+{
+	using namespace BELightSmootherTest;
+
+	const int32 FrameRates[] = { 20, 60, 240 };
+	const FQuat FinalTarget = SampleTrace(TraceTicks);
+	const FTraceRun Reference = RunTrace(SubstepsPerSecond, false);
+
+	for (const int32 FrameRate : FrameRates)
+	{
+		const FTraceRun Run = RunTrace(FrameRate, false);
+
+		TestTrue(*FString::Printf(TEXT("Settled pose at %d fps matches the target"), FrameRate),
+			AngleDegrees(Run.SettledRotation, FinalTarget) <= SettleToleranceDegrees);
+
+		if (!TestEqual(*FString::Printf(TEXT("Checkpoint count at %d fps"), FrameRate), Run.Lag.Num(), Reference.Lag.Num())){continue;}
+
+		for (int32 Index = 0; Index < Run.Lag.Num(); ++Index)
+		{
+			TestEqual(*FString::Printf(TEXT("Lag at %d fps, %.2f s"), FrameRate, (Index + 1) * CheckpointTicks / static_cast<float>(SubstepsPerSecond)),
+				Run.Lag[Index], Reference.Lag[Index], LagToleranceDegrees);
+		}
+
+		// Prediction extrapolates per frame, so only the settled pose is expected to match.
+		const FTraceRun PredictedRun = RunTrace(FrameRate, true);
+		TestTrue(*FString::Printf(TEXT("Predicted settled pose at %d fps matches the target"), FrameRate),
+			AngleDegrees(PredictedRun.SettledRotation, FinalTarget) <= SettleToleranceDegrees);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBELightSmootherHitchTest, "BrightEye.LightSmoother.HitchClamp",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBELightSmootherHitchTest::RunTest(const FString& Parameters)
+{
+	using namespace BELightSmootherTest;
+
+	constexpr float HitchTime = 0.5f;
+	constexpr int32 WarmupFrames = 30;
+
+	for (const bool bPredict : { false, true })
+	{
+		FBELightSmoother Hitched;
+		FBELightSmoother Capped;
+		Hitched.Reset(FQuat::Identity);
+		Capped.Reset(FQuat::Identity);
+
+		// A slow pan first, so prediction has a velocity to extrapolate when the hitch hits.
+		for (int32 Frame = 0; Frame < WarmupFrames; ++Frame)
+		{
+			const FQuat Target = FRotator(0.0f, Frame * 0.5f, 0.0f).Quaternion();
+			Hitched.Update(Target, 1.0f / 60.0f, HalfLife, bPredict);
+			Capped.Update(Target, 1.0f / 60.0f, HalfLife, bPredict);
+		}
+
+		const FQuat Before = Hitched.GetRotation();
+		const FQuat Target = FRotator(0.0f, 120.0f, 0.0f).Quaternion();
+		Hitched.Update(Target, HitchTime, HalfLife, bPredict);
+		Capped.Update(Target, FBELightSmoother::MaxFrameTime, HalfLife, bPredict);
+
+		const TCHAR* Mode = bPredict ? TEXT("with prediction") : TEXT("without prediction");
+		TestTrue(*FString::Printf(TEXT("A %.1f s hitch advances like MaxFrameTime %s"), HitchTime, Mode),
+			AngleDegrees(Hitched.GetRotation(), Capped.GetRotation()) <= SettleToleranceDegrees);
+		TestTrue(*FString::Printf(TEXT("The light moves during the hitch %s"), Mode),
+			AngleDegrees(Hitched.GetRotation(), Before) > 1.0f);
+		TestTrue(*FString::Printf(TEXT("The light does not snap to the target after the hitch %s"), Mode),
+			AngleDegrees(Hitched.GetRotation(), Target) > 10.0f);
+	}
+
+	return true;
+}
+
+#endif
@@ -5,8 +5,9 @@
 #include "CursorTrackerWidget.h"
 #include "ScalarEntryWidget.h"
 #include "Data/BrightEyeSettings.h"
-#include "Data/ColorPicker.h"
+#include "Data/LightRig.h"
 #include "Data/PanelFadeOutManager.h"
+#include "System/BrightEyeStats.h"
 #include "System/BrightEyeStyle.h"
 #include "Viewports/InViewportUIDragOperation.h"
 #include "Widgets/Layout/SBorder.h"
@@ -21,18 +22,40 @@ constexpr float DefaultStartDelay = 0.8f;
 
 void SBrightEyePanel::Construct(const FArguments& InArgs)
 {
-	Owner = InArgs._Owner;
+	// Paired with the destructor; a count that keeps growing means a panel is still referenced after being destroyed.
+	INC_DWORD_STAT(STAT_BrightEyeLivePanels);
+	++FBrightEyeLiveCounts::Panels;
+
 	OnPanelDragStartedSignature = InArgs._OnPanelDragStarted;
 	OnPanelDragFinishedSignature = InArgs._OnPanelDragFinished;
 	OnBrightnessChangedSignature = InArgs._OnBrightnessChanged;
 	OnRadiusChangedSignature = InArgs._OnRadiusChanged;
 	OnDistanceChangedSignature = InArgs._OnDistanceChanged;
 	OnSmoothRotationStateChanged = InArgs._OnSmoothRotationStateChanged;
+	OnStampsToggledSignature = InArgs._OnStampsToggled;
+	OnStampsRecoloredSignature = InArgs._OnStampsRecolored;
+	OnStampsScaledSignature = InArgs._OnStampsScaled;
+	OnStampsClearedSignature = InArgs._OnStampsCleared;
+	OnStampsConvertedSignature = InArgs._OnStampsConverted;
+	RigLightCount = InArgs._RigLightCount;
+	IsRigLightEnabledSignature = InArgs._IsRigLightEnabled;
+	OnRigLightToggledSignature = InArgs._OnRigLightToggled;
+	OnRigPresetCycledSignature = InArgs._OnRigPresetCycled;
 
 	const FSlateBrush* SRSlateBrush = GetSmoothRotationButtonImage();
 
 	UBESettings* BESettings = UBESettings::GetInstance();
 	if(!IsValid(BESettings)){return;}
+
+	TSharedRef<SHorizontalBox> RigLightButtons = SNew(SHorizontalBox);
+	for (int32 Index = 0; Index < FBELightRig::MaxLights; ++Index)
+	{
+		RigLightButtons->AddSlot()
+		.AutoWidth()
+		[
+			MakeRigLightButton(Index)
+		];
+	}
 	
 	ChildSlot
 	[
@@ -85,12 +108,13 @@ void SBrightEyePanel::Construct(const FArguments& InArgs)
 					})
 					.OnMouseDoubleClick_Lambda([this](const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
 					{
-						if(!ScalarParamBox.IsValid() || !LightCoordOverlay.IsValid()){return FReply::Handled();}
+						if(!ScalarParamBox.IsValid() || !LightCoordOverlay.IsValid() || !LightColorWidget.IsValid()){return FReply::Handled();}
 
 						bool bIsInScalarMode = ScalarParamBox->GetVisibility() == EVisibility::Visible;
 
 						ScalarParamBox->SetVisibility(bIsInScalarMode ? EVisibility::Hidden : EVisibility::Visible);
 						LightCoordOverlay->SetVisibility(bIsInScalarMode ? EVisibility::Visible : EVisibility::Hidden);
+						LightColorWidget->SetVisibility(EVisibility::Hidden);
 
 						return FReply::Handled();
 					})
@@ -217,6 +241,127 @@ void SBrightEyePanel::Construct(const FArguments& InArgs)
 							]
 						]
 					]
+
+					+SOverlay::Slot()
+					[
+						SAssignNew(LightColorWidget, SLightColorWidget)
+						.Visibility(EVisibility::Hidden)
+						.InitialColor(BESettings->Color)
+						.InitialTemperature(BESettings->ColorTemperature)
+						.OnColorChanged(InArgs._OnColorChanged)
+						.OnTemperatureChanged(InArgs._OnTemperatureChanged)
+					]
+				]
+			]
+
+			+ SVerticalBox::Slot()
+			.Padding(FMargin(1.0f))
+			.AutoHeight()
+			[
+				SNew(SHorizontalBox)
+
+				+ SHorizontalBox::Slot()
+				.FillWidth(1)
+				.VAlign(VAlign_Center)
+				.Padding(FMargin(4.0f, 0.0f))
+				[
+					SNew(STextBlock)
+					.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+					.Text(InArgs._RigSummary)
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					RigLightButtons
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					MakeStampButton(FText::FromString("Rig"), FText::FromString("Switch to the next light rig preset"),
+						FOnClicked::CreateLambda([this]()
+						{
+							OnRigPresetCycledSignature.ExecuteIfBound();
+							return FReply::Handled();
+						}))
+				]
+			]
+
+			+ SVerticalBox::Slot()
+			.Padding(FMargin(5.0f, 1.0f))
+			.AutoHeight()
+			[
+				SNew(STextBlock)
+				.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+				.ColorAndOpacity(FColor::FromHex("#cfcfcf"))
+				.Text(InArgs._LightCostSummary)
+			]
+
+			+ SVerticalBox::Slot()
+			.Padding(FMargin(1.0f))
+			.AutoHeight()
+			[
+				SNew(SHorizontalBox)
+
+				+ SHorizontalBox::Slot()
+				.FillWidth(1)
+				.VAlign(VAlign_Center)
+				.Padding(FMargin(4.0f, 0.0f))
+				[
+					SNew(STextBlock)
+					.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+					.Text(InArgs._StampSummary)
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					MakeStampButton(FText::FromString("I/O"), FText::FromString("Enable or disable all light stamps"),
+						FOnClicked::CreateStatic(&SBrightEyePanel::ExecuteStampAction, OnStampsToggledSignature))
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					MakeStampButton(FText::FromString("-"), FText::FromString("Dim all light stamps"),
+						FOnClicked::CreateLambda([this]()
+						{
+							OnStampsScaledSignature.ExecuteIfBound(0.8f);
+							return FReply::Handled();
+						}))
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					MakeStampButton(FText::FromString("+"), FText::FromString("Brighten all light stamps"),
+						FOnClicked::CreateLambda([this]()
+						{
+							OnStampsScaledSignature.ExecuteIfBound(1.25f);
+							return FReply::Handled();
+						}))
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					MakeStampButton(FText::FromString("Tint"), FText::FromString("Apply the Bright Eye color to all light stamps"),
+						FOnClicked::CreateStatic(&SBrightEyePanel::ExecuteStampAction, OnStampsRecoloredSignature))
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					MakeStampButton(FText::FromString("Clear"), FText::FromString("Remove all light stamps"),
+						FOnClicked::CreateStatic(&SBrightEyePanel::ExecuteStampAction, OnStampsClearedSignature))
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					MakeStampButton(FText::FromString("Bake"), FText::FromString("Convert all light stamps to spot light actors"),
+						FOnClicked::CreateStatic(&SBrightEyePanel::ExecuteStampAction, OnStampsConvertedSignature))
 				]
 			]
 		]
@@ -239,33 +384,79 @@ FReply SBrightEyePanel::OnSmoothRotationButtonClicked() const
 
 
 
-FReply SBrightEyePanel::OnColorButtonClicked() const
+TSharedRef<SWidget> SBrightEyePanel::MakeStampButton(const FText& InLabel, const FText& InToolTip, FOnClicked InOnClicked) const
 {
-	if(IsValid(ColorPicker))
-	{
-		ColorPicker->OpenColorPickerInternal();
-	}
-	return FReply::Handled();
+	return SNew(SBox)
+		.HeightOverride(22.0f)
+		.Padding(FMargin(1.0f, 0.0f))
+		[
+			SNew(SButton)
+			.ButtonStyle(FBrightEyeStyle::GetCreatedToolSlateStyleSet(),TEXT("BrightEye.BrightEyeButtonStyle"))
+			.ToolTipText(InToolTip)
+			.HAlign(HAlign_Center)
+			.VAlign(VAlign_Center)
+			.OnClicked(InOnClicked)
+			[
+				SNew(STextBlock)
+				.Font(FCoreStyle::GetDefaultFontStyle("Bold", 8))
+				.ColorAndOpacity(FColor::FromHex("#cfcfcf"))
+				.Text(InLabel)
+			]
+		];
 }
 
+TSharedRef<SWidget> SBrightEyePanel::MakeRigLightButton(const int32 InIndex)
+{
+	return SNew(SBox)
+		.WidthOverride(22.0f)
+		.HeightOverride(22.0f)
+		.Padding(FMargin(1.0f, 0.0f))
+		.Visibility_Lambda([this, InIndex]()
+		{
+			return InIndex < RigLightCount.Get(0) ? EVisibility::Visible : EVisibility::Collapsed;
+		})
+		[
+			SNew(SButton)
+			.ButtonStyle(FBrightEyeStyle::GetCreatedToolSlateStyleSet(),TEXT("BrightEye.BrightEyeButtonStyle"))
+			.ToolTipText(FText::Format(FText::FromString("Turn rig light {0} on or off"), FText::AsNumber(InIndex + 1)))
+			.HAlign(HAlign_Center)
+			.VAlign(VAlign_Center)
+			.OnClicked_Lambda([this, InIndex]()
+			{
+				OnRigLightToggledSignature.ExecuteIfBound(InIndex);
+				return FReply::Handled();
+			})
+			[
+				SNew(STextBlock)
+				.Font(FCoreStyle::GetDefaultFontStyle("Bold", 8))
+				.ColorAndOpacity_Lambda([this, InIndex]()
+				{
+					const bool bIsEnabled = IsRigLightEnabledSignature.IsBound() && IsRigLightEnabledSignature.Execute(InIndex);
+					return FSlateColor(FColor::FromHex(bIsEnabled ? "#cfcfcf" : "#5a5a5a"));
+				})
+				.Text(FText::AsNumber(InIndex + 1))
+			]
+		];
+}
 
-bool SBrightEyePanel::InitializeTheColorPicker()
+FReply SBrightEyePanel::ExecuteStampAction(FOnStampActionSignature InAction)
 {
-	if (!IsValid(ColorPicker) && Owner.IsValid())
-	{
-		ColorPicker = NewObject<UBEColorPicker>(Owner.Get());
-		return true;
-	}
-	return false;
+	InAction.ExecuteIfBound();
+	return FReply::Handled();
 }
 
-UBEColorPicker* SBrightEyePanel::GetColorPicker()
+FReply SBrightEyePanel::OnColorButtonClicked() const
 {
-	if(!IsValid(ColorPicker))
-	{
-		InitializeTheColorPicker();
-	}
-	return ColorPicker;
+	if(!ScalarParamBox.IsValid() || !LightCoordOverlay.IsValid() || !LightColorWidget.IsValid()){return FReply::Handled();}
+
+	// The color controls share the parameter area with the sliders, so opening them never leaves the viewport.
+	const bool bIsInColorMode = LightColorWidget->GetVisibility() == EVisibility::Visible;
+
+	LightColorWidget->SetVisibility(bIsInColorMode ? EVisibility::Hidden : EVisibility::Visible);
+	ScalarParamBox->SetVisibility(bIsInColorMode ? EVisibility::Visible : EVisibility::Hidden);
+	LightCoordOverlay->SetVisibility(EVisibility::Hidden);
+
+	return FReply::Handled();
 }
 
 void SBrightEyePanel::RefreshPanel() const
@@ -276,7 +467,7 @@ void SBrightEyePanel::RefreshPanel() const
 	if(BrightnessEntry.IsValid()){BrightnessEntry->UpdateProgressManually(BESettings->Brightness);}
 	if(RadiusEntry.IsValid()){RadiusEntry->UpdateProgressManually(BESettings->Radius);}
 	if(DistanceEntry.IsValid()){DistanceEntry->UpdateProgressManually(BESettings->Distance);}
-	if(IsValid(ColorPicker)){ColorPicker->InitializeColor(BESettings->Color);}
+	RefreshColor();
 	RefreshCameraRotationState();
 }
 
@@ -309,7 +500,10 @@ void SBrightEyePanel::RefreshCameraRotationState() const
 void SBrightEyePanel::RefreshColor() const
 {
 	UBESettings* BESettings = UBESettings::GetInstance();
-	if(IsValid(ColorPicker)){ColorPicker->InitializeColor(BESettings->Color);}
+	if(!IsValid(BESettings) || !LightColorWidget.IsValid()){return;}
+
+	LightColorWidget->SetColor(BESettings->Color);
+	LightColorWidget->SetTemperature(BESettings->ColorTemperature);
 }
 
 void SBrightEyePanel::ChangeHidePanelWhenIdle(bool InHidePanelWhenIdle)
@@ -404,16 +598,13 @@ void SBrightEyePanel::CreateFadeOutManager()
 {
 	if (!FadeOutManager)
 	{
-		FadeOutManager = new FPanelFadeOutManager(); 
+		FadeOutManager = MakeUnique<FPanelFadeOutManager>();
 	}
 }
 
 
 SBrightEyePanel::~SBrightEyePanel()
 {
-	if (FadeOutManager)
-	{
-		delete FadeOutManager; 
-		FadeOutManager = nullptr;
-	}
+	DEC_DWORD_STAT(STAT_BrightEyeLivePanels);
+	--FBrightEyeLiveCounts::Panels;
 }
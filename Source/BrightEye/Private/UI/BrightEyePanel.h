@@ -5,15 +5,20 @@
 
 #include "CoreMinimal.h"
 #include "CursorTrackerWidget.h"
+#include "LightColorWidget.h"
 #include "Widgets/SCompoundWidget.h"
 
 struct FPanelFadeOutManager;
-class UBEColorPicker;
 
 DECLARE_DELEGATE(FOnSmoothRotationStateChangedSignature);
 DECLARE_DELEGATE_OneParam(FOnScalarValueChangedSignature, const float& /* Value */);
 DECLARE_DELEGATE(FOnPanelDragStartedSignature)
 DECLARE_DELEGATE_OneParam(FOnPanelDragFinishedSignature,const FVector2D& /* Drop Location */)
+DECLARE_DELEGATE(FOnStampActionSignature)
+DECLARE_DELEGATE_OneParam(FOnStampScaleSignature, float /* Scale */)
+DECLARE_DELEGATE(FOnRigPresetCycledSignature)
+DECLARE_DELEGATE_OneParam(FOnRigLightToggledSignature, int32 /* Light Index */)
+DECLARE_DELEGATE_RetVal_OneParam(bool, FIsRigLightEnabledSignature, int32 /* Light Index */)
 
 
 class SScalarEntryWidget;
@@ -27,7 +32,6 @@ class BRIGHTEYE_API SBrightEyePanel final : public SCompoundWidget
 {
 public:
 	SLATE_BEGIN_ARGS(SBrightEyePanel){}
-	SLATE_ARGUMENT(UObject*, Owner);
 	SLATE_EVENT(FOnPanelDragStartedSignature, OnPanelDragStarted)
 	SLATE_EVENT(FOnPanelDragFinishedSignature, OnPanelDragFinished)
 	SLATE_EVENT(FOnScalarValueChangedSignature, OnBrightnessChanged)
@@ -35,6 +39,20 @@ public:
 	SLATE_EVENT(FOnScalarValueChangedSignature, OnDistanceChanged)
 	SLATE_EVENT(FOnCoordChangedSignature, OnCoordsChanged)
 	SLATE_EVENT(FOnSmoothRotationStateChangedSignature, OnSmoothRotationStateChanged)
+	SLATE_EVENT(FOnLightColorChanged, OnColorChanged)
+	SLATE_EVENT(FOnLightTemperatureChanged, OnTemperatureChanged)
+	SLATE_ATTRIBUTE(FText, RigSummary)
+	SLATE_ATTRIBUTE(int32, RigLightCount)
+	SLATE_EVENT(FIsRigLightEnabledSignature, IsRigLightEnabled)
+	SLATE_EVENT(FOnRigLightToggledSignature, OnRigLightToggled)
+	SLATE_EVENT(FOnRigPresetCycledSignature, OnRigPresetCycled)
+	SLATE_ATTRIBUTE(FText, LightCostSummary)
+	SLATE_ATTRIBUTE(FText, StampSummary)
+	SLATE_EVENT(FOnStampActionSignature, OnStampsToggled)
+	SLATE_EVENT(FOnStampActionSignature, OnStampsRecolored)
+	SLATE_EVENT(FOnStampScaleSignature, OnStampsScaled)
+	SLATE_EVENT(FOnStampActionSignature, OnStampsCleared)
+	SLATE_EVENT(FOnStampActionSignature, OnStampsConverted)
 SLATE_END_ARGS()
 	
 	/** Constructs this widget with InArgs */
@@ -43,12 +61,7 @@ SLATE_END_ARGS()
 	FReply OnSmoothRotationButtonClicked() const;
 	FReply OnColorButtonClicked() const;
 	
-	bool InitializeTheColorPicker();
-	UBEColorPicker* GetColorPicker();
-	
 private:
-	TWeakObjectPtr<UObject> Owner;
-	
 	TSharedPtr<SScalarEntryWidget> BrightnessEntry;
 	TSharedPtr<SScalarEntryWidget> RadiusEntry;
 	TSharedPtr<SScalarEntryWidget> DistanceEntry;
@@ -56,6 +69,7 @@ private:
 	
 	TSharedPtr<SWidget> ScalarParamBox;
 	TSharedPtr<SWidget> LightCoordOverlay;
+	TSharedPtr<SLightColorWidget> LightColorWidget;
 	
 	TSharedPtr<SCursorTrackerWidget> CursorTrackerWidget;
 
@@ -63,6 +77,21 @@ private:
 	FOnScalarValueChangedSignature OnRadiusChangedSignature;
 	FOnScalarValueChangedSignature OnDistanceChangedSignature;
 
+	FOnStampActionSignature OnStampsToggledSignature;
+	FOnStampActionSignature OnStampsRecoloredSignature;
+	FOnStampScaleSignature OnStampsScaledSignature;
+	FOnStampActionSignature OnStampsClearedSignature;
+	FOnStampActionSignature OnStampsConvertedSignature;
+
+	TAttribute<int32> RigLightCount;
+	FIsRigLightEnabledSignature IsRigLightEnabledSignature;
+	FOnRigLightToggledSignature OnRigLightToggledSignature;
+	FOnRigPresetCycledSignature OnRigPresetCycledSignature;
+
+	TSharedRef<SWidget> MakeStampButton(const FText& InLabel, const FText& InToolTip, FOnClicked InOnClicked) const;
+	TSharedRef<SWidget> MakeRigLightButton(int32 InIndex);
+	static FReply ExecuteStampAction(FOnStampActionSignature InAction);
+
 public:
 	FOnSmoothRotationStateChangedSignature OnSmoothRotationStateChanged;
 
@@ -82,8 +111,6 @@ private:
 
 	bool bHidePanelWhenIdle = false;
 
-	TObjectPtr<UBEColorPicker> ColorPicker = nullptr;
-
 #pragma region Drag&Drop
 	
 	FOnPanelDragStartedSignature OnPanelDragStartedSignature;
@@ -98,7 +125,7 @@ private:
 
 private:
 	//Fadeout Management
-	FPanelFadeOutManager* FadeOutManager = nullptr;
+	TUniquePtr<FPanelFadeOutManager> FadeOutManager;
 	
 	void CreateFadeOutManager();
 
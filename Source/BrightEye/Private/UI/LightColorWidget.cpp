@@ -0,0 +1,187 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#include "LightColorWidget.h"
+#include "System/BrightEyeStyle.h"
+#include "Widgets/Colors/SColorBlock.h"
+#include "Widgets/Colors/SColorWheel.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSlider.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Text/STextBlock.h"
+
+constexpr float NeutralTemperature = 6500.0f;
+
+void SLightColorWidget::Construct(const FArguments& InArgs)
+{
+	OnColorChanged = InArgs._OnColorChanged;
+	OnTemperatureChanged = InArgs._OnTemperatureChanged;
+	HSVColor = InArgs._InitialColor.LinearRGBToHSV();
+
+	ChildSlot
+	[
+		SNew(SBorder)
+		.BorderBackgroundColor(FLinearColor(0, 0, 0, 0.6))
+		.BorderImage(EditorStyle::GetBrush("Brushes.Panel"))
+		.Padding(3)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			[
+				SNew(SBox)
+				.WidthOverride(80)
+				.HeightOverride(80)
+				[
+					SNew(SColorWheel)
+					.SelectedColor(this, &SLightColorWidget::GetWheelColor)
+					.OnValueChanged(this, &SLightColorWidget::OnWheelValueChanged)
+				]
+			]
+
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			.VAlign(VAlign_Center)
+			.Padding(FMargin(6.0f, 0.0f, 2.0f, 0.0f))
+			[
+				SNew(SVerticalBox)
+
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(FMargin(0.0f, 1.0f))
+				[
+					SNew(SHorizontalBox)
+
+					+ SHorizontalBox::Slot()
+					.FillWidth(1.0f)
+					.VAlign(VAlign_Center)
+					[
+						SNew(STextBlock)
+						.Text(FText::FromString("Temperature"))
+						.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+					]
+
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.VAlign(VAlign_Center)
+					[
+						SAssignNew(TemperatureText, STextBlock)
+						.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+					]
+				]
+
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(FMargin(0.0f, 1.0f))
+				[
+					SNew(SBox)
+					.HeightOverride(18)
+					[
+						SAssignNew(TemperatureSlider, SSlider)
+						.MinValue(MinTemperature)
+						.MaxValue(MaxTemperature)
+						.Value(FMath::Clamp(InArgs._InitialTemperature, MinTemperature, MaxTemperature))
+						.OnValueChanged(this, &SLightColorWidget::OnTemperatureSliderChanged)
+						.Style(&FBrightEyeStyle::GetCreatedToolSlateStyleSet()->GetWidgetStyle<FSliderStyle>("BrightEye.Slider"))
+					]
+				]
+
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(FMargin(0.0f, 3.0f, 0.0f, 0.0f))
+				[
+					SNew(SHorizontalBox)
+
+					+ SHorizontalBox::Slot()
+					.FillWidth(1.0f)
+					.VAlign(VAlign_Center)
+					[
+						SNew(SBox)
+						.HeightOverride(16)
+						[
+							SNew(SColorBlock)
+							.Color(this, &SLightColorWidget::GetPreviewColor)
+							.ShowBackgroundForAlpha(false)
+						]
+					]
+
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.Padding(FMargin(4.0f, 0.0f, 0.0f, 0.0f))
+					[
+						SNew(SBox)
+						.HeightOverride(20.0f)
+						[
+							SNew(SButton)
+							.ButtonStyle(FBrightEyeStyle::GetCreatedToolSlateStyleSet(),TEXT("BrightEye.BrightEyeButtonStyle"))
+							.ToolTipText(FText::FromString("Reset to neutral white"))
+							.HAlign(HAlign_Center)
+							.VAlign(VAlign_Center)
+							.OnClicked_Lambda([this]()
+							{
+								OnWheelValueChanged(FLinearColor(0.0f, 0.0f, HSVColor.B));
+								TemperatureSlider->SetValue(NeutralTemperature);
+								OnTemperatureSliderChanged(NeutralTemperature);
+								return FReply::Handled();
+							})
+							[
+								SNew(STextBlock)
+								.Font(FCoreStyle::GetDefaultFontStyle("Bold", 8))
+								.ColorAndOpacity(FColor::FromHex("#cfcfcf"))
+								.Text(FText::FromString("White"))
+							]
+						]
+					]
+				]
+			]
+		]
+	];
+
+	RefreshTemperatureText(TemperatureSlider->GetValue());
+}
+
+void SLightColorWidget::SetColor(const FLinearColor& InColor)
+{
+	const FLinearColor NewHSVColor = InColor.LinearRGBToHSV();
+
+	// Fully desaturated colors carry no hue, so the wheel keeps the last one instead of jumping to red.
+	HSVColor = FLinearColor(NewHSVColor.G > 0.0f ? NewHSVColor.R : HSVColor.R, NewHSVColor.G, NewHSVColor.B);
+}
+
+void SLightColorWidget::SetTemperature(const float InTemperature) const
+{
+	if (!TemperatureSlider.IsValid()) { return; }
+
+	TemperatureSlider->SetValue(FMath::Clamp(InTemperature, MinTemperature, MaxTemperature));
+	RefreshTemperatureText(TemperatureSlider->GetValue());
+}
+
+FLinearColor SLightColorWidget::GetPreviewColor() const
+{
+	const float Temperature = TemperatureSlider.IsValid() ? TemperatureSlider->GetValue() : NeutralTemperature;
+	return HSVColor.HSVToLinearRGB() * FLinearColor::MakeFromColorTemperature(Temperature);
+}
+
+void SLightColorWidget::OnWheelValueChanged(const FLinearColor InHSVColor)
+{
+	HSVColor = InHSVColor;
+
+	OnColorChanged.ExecuteIfBound(HSVColor.HSVToLinearRGB());
+}
+
+void SLightColorWidget::OnTemperatureSliderChanged(const float InTemperature) const
+{
+	RefreshTemperatureText(InTemperature);
+
+	OnTemperatureChanged.ExecuteIfBound(InTemperature);
+}
+
+void SLightColorWidget::RefreshTemperatureText(const float InTemperature) const
+{
+	if (!TemperatureText.IsValid()) { return; }
+
+	TemperatureText->SetText(FText::FromString(FString::Printf(TEXT("%.0f K"), InTemperature)));
+}
@@ -0,0 +1,59 @@
+﻿// Copyright (c) 2024 PullsarDev - GitHub: https://github.com/PullsarDev
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+
+class SColorBlock;
+class SSlider;
+class STextBlock;
+
+DECLARE_DELEGATE_OneParam(FOnLightColorChanged, const FLinearColor& /* Color */);
+DECLARE_DELEGATE_OneParam(FOnLightTemperatureChanged, const float& /* Kelvin */);
+
+/**
+ * Compact inline color control for the Bright Eye panel, made of a hue/saturation wheel and a color temperature slider.
+ * It is built once with the panel and only reports interactive changes; values pushed back from the settings do not echo.
+ */
+class BRIGHTEYE_API SLightColorWidget : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SLightColorWidget)
+		: _InitialColor(FLinearColor::White)
+		, _InitialTemperature(6500.0f)
+		{}
+
+	SLATE_ARGUMENT(FLinearColor, InitialColor)
+	SLATE_ARGUMENT(float, InitialTemperature)
+	SLATE_EVENT(FOnLightColorChanged, OnColorChanged)
+	SLATE_EVENT(FOnLightTemperatureChanged, OnTemperatureChanged)
+SLATE_END_ARGS()
+
+	/** Constructs this widget with InArgs */
+	void Construct(const FArguments& InArgs);
+
+	void SetColor(const FLinearColor& InColor);
+	void SetTemperature(float InTemperature) const;
+
+	static constexpr float MinTemperature = 1700.0f;
+	static constexpr float MaxTemperature = 12000.0f;
+
+private:
+	FLinearColor GetWheelColor() const { return HSVColor; }
+	FLinearColor GetPreviewColor() const;
+
+	void OnWheelValueChanged(FLinearColor InHSVColor);
+	void OnTemperatureSliderChanged(float InTemperature) const;
+	void RefreshTemperatureText(float InTemperature) const;
+
+	// The wheel works in HSV; value is kept from the incoming color since brightness is driven separately.
+	FLinearColor HSVColor = FLinearColor(0.0f, 0.0f, 1.0f);
+
+	TSharedPtr<SSlider> TemperatureSlider;
+	TSharedPtr<STextBlock> TemperatureText;
+
+	FOnLightColorChanged OnColorChanged;
+	FOnLightTemperatureChanged OnTemperatureChanged;
+};